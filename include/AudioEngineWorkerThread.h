@@ -117,6 +117,8 @@ private:
 	static QList<AudioEngineWorkerThread *> workerThreads;
 
 	volatile bool m_quit;
+	//! Position among the worker threads, used for CPU pinning
+	int m_index;
 } ;
 
 } // namespace lmms
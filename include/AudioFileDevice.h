@@ -26,6 +26,9 @@
 #ifndef LMMS_AUDIO_FILE_DEVICE_H
 #define LMMS_AUDIO_FILE_DEVICE_H
 
+#include <cstdint>
+#include <vector>
+
 #include <QFile>
 
 #include "AudioDevice.h"
@@ -53,6 +56,17 @@ public:
 protected:
 	int writeData( const void* data, int len );
 
+	//! Encodes @p frames interleaved frames. The encoder may modify the samples in place.
+	//! The periods rendered are collected, so this is called with up to BlockFrames frames.
+	virtual void encodeBlock( float* interleaved, f_cnt_t frames ) = 0;
+
+	//! Encodes the frames collected so far, to be called before the encoder is finished
+	void flushBlock();
+
+	//! Converts interleaved samples to signed 16 bit in a buffer kept by the device,
+	//! applying TPDF dither if enabled in the output settings
+	const int_sample_t* convertToInt16( const float* interleaved, f_cnt_t frames );
+
 	inline bool outputFileOpened() const
 	{
 		return m_outputFile.isOpen();
@@ -64,8 +78,17 @@ protected:
 	}
 
 private:
+	void writeBuffer( const surroundSampleFrame* ab, const fpp_t frames ) override;
+
+	static constexpr f_cnt_t BlockFrames = 8192;
+
 	QFile m_outputFile;
 	OutputSettings m_outputSettings;
+
+	std::vector<float> m_block;
+	f_cnt_t m_blockFrames;
+	std::vector<int_sample_t> m_int16Buffer;
+	std::uint32_t m_ditherSeed;
 } ;
 
 using AudioFileDeviceInstantiaton
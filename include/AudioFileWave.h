@@ -56,7 +56,7 @@ public:
 
 
 private:
-	void writeBuffer(const surroundSampleFrame* _ab, const fpp_t _frames) override;
+	void encodeBlock( float* interleaved, f_cnt_t frames ) override;
 
 	bool startEncoding();
 	void finishEncoding();
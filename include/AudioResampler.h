@@ -53,6 +53,8 @@ public:
 	auto interpolationMode() const -> int { return m_interpolationMode; }
 	auto channels() const -> int { return m_channels; }
 	void setRatio(double ratio);
+	//! Clears the internal state, e.g. to reuse the resampler for another stream
+	void reset();
 
 private:
 	int m_interpolationMode = -1;
@@ -40,6 +40,7 @@
 #include "lmms_basics.h"
 #include "lmms_constants.h"
 #include "interpolation.h"
+#include "denormals.h"
 
 namespace lmms
 {
@@ -123,7 +124,7 @@ public:
 		m_z4[ch] = m_z3[ch];
 		m_z3[ch] = m_z2[ch];
 		m_z2[ch] = m_z1[ch];
-		m_z1[ch] = x;
+		m_z1[ch] = denormal_guard(x);
 		
 		return y;
 	}
@@ -175,8 +176,8 @@ public:
 	{
 		// biquad filter in transposed form
 		const float out = m_z1[ch] + m_b0 * in;
-		m_z1[ch] = m_b1 * in + m_z2[ch] - m_a1 * out;
-		m_z2[ch] = m_b2 * in - m_a2 * out;
+		m_z1[ch] = denormal_guard(m_b1 * in + m_z2[ch] - m_a1 * out);
+		m_z2[ch] = denormal_guard(m_b2 * in - m_a2 * out);
 		return out;
 	}
 private:
@@ -345,7 +346,7 @@ public:
 		{
 			case FilterType::Moog:
 			{
-				sample_t x = _in0 - m_r*m_y4[_chnl];
+				sample_t x = denormal_guard(_in0 - m_r*m_y4[_chnl]);
 
 				// four cascaded onepole filters
 				// (bilinear transform)
@@ -379,7 +380,7 @@ public:
 				for( int i = 0; i < 4; ++i )
 				{
 					ip += 0.25f;
-					sample_t x = linearInterpolate( m_last[_chnl], _in0, ip ) - m_r * m_y3[_chnl];
+					sample_t x = denormal_guard(linearInterpolate(m_last[_chnl], _in0, ip) - m_r * m_y3[_chnl]);
 					
 					m_y1[_chnl] = std::clamp((x + m_oldx[_chnl]) * m_p
 							- m_k * m_y1[_chnl], -10.0f,
@@ -412,11 +413,11 @@ public:
 				
 				for( int i = 0; i < 2; ++i ) // 2x oversample
 				{
-					m_delay2[_chnl] = m_delay2[_chnl] + m_svf1 * m_delay1[_chnl];				/* delay2/4 = lowpass output */
+					m_delay2[_chnl] = denormal_guard(m_delay2[_chnl] + m_svf1 * m_delay1[_chnl]);				/* delay2/4 = lowpass output */
 					highpass = _in0 - m_delay2[_chnl] - m_svq * m_delay1[_chnl];
 					m_delay1[_chnl] = m_svf1 * highpass + m_delay1[_chnl];           			/* delay1/3 = bandpass output */
 
-					m_delay4[_chnl] = m_delay4[_chnl] + m_svf2 * m_delay3[_chnl];
+					m_delay4[_chnl] = denormal_guard(m_delay4[_chnl] + m_svf2 * m_delay3[_chnl]);
 					highpass = m_delay2[_chnl] - m_delay4[_chnl] - m_svq * m_delay3[_chnl];
 					m_delay3[_chnl] = m_svf2 * highpass + m_delay3[_chnl];
 				}
@@ -432,7 +433,7 @@ public:
 				float hp;
 				for( int i = 0; i < 2; ++i ) // 2x oversample
 				{				
-					m_delay2[_chnl] = m_delay2[_chnl] + m_svf1 * m_delay1[_chnl];
+					m_delay2[_chnl] = denormal_guard(m_delay2[_chnl] + m_svf1 * m_delay1[_chnl]);
 					hp = _in0 - m_delay2[_chnl] - m_svq * m_delay1[_chnl];
 					m_delay1[_chnl] = m_svf1 * hp + m_delay1[_chnl];
 				}
@@ -445,11 +446,11 @@ public:
 				float hp1;
 				for( int i = 0; i < 2; ++i ) // 2x oversample
 				{
-					m_delay2[_chnl] = m_delay2[_chnl] + m_svf1 * m_delay1[_chnl];				/* delay2/4 = lowpass output */
+					m_delay2[_chnl] = denormal_guard(m_delay2[_chnl] + m_svf1 * m_delay1[_chnl]);				/* delay2/4 = lowpass output */
 					hp1 = _in0 - m_delay2[_chnl] - m_svq * m_delay1[_chnl];
 					m_delay1[_chnl] = m_svf1 * hp1 + m_delay1[_chnl];           			/* delay1/3 = bandpass output */
 
-					m_delay4[_chnl] = m_delay4[_chnl] + m_svf2 * m_delay3[_chnl];
+					m_delay4[_chnl] = denormal_guard(m_delay4[_chnl] + m_svf2 * m_delay3[_chnl]);
 					float hp2 = m_delay2[_chnl] - m_delay4[_chnl] - m_svq * m_delay3[_chnl];
 					m_delay3[_chnl] = m_svf2 * hp2 + m_delay3[_chnl];
 				}
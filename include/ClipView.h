@@ -135,6 +135,7 @@ public slots:
 	virtual bool close();
 	void remove();
 	void update() override;
+	void updateLength();
 
 	void selectColor();
 	void randomizeColor();
@@ -188,7 +189,6 @@ protected:
 	auto hasCustomColor() const -> bool;
 
 protected slots:
-	void updateLength();
 	void updatePosition();
 
 
@@ -74,6 +74,10 @@ public:
 	QString nameWithExtension( const QString& fn ) const;
 
 	void write( QTextStream& strm );
+	//! Returns the written document, compressed if @p compressed is true.
+	//! Unlike writeFile(), this never interacts with the user, so it may be
+	//! called from any thread owning this DataFile.
+	QByteArray serialize(bool compressed);
 	bool writeFile(const QString& fn, bool withResources = false);
 	bool copyResources(const QString& resourcesDir); //!< Copies resources to the resourcesDir and changes the DataFile to use local paths to them
 	bool hasLocalPlugins(QDomElement parent = QDomElement(), bool firstCall = true) const;
@@ -26,7 +26,9 @@
 #ifndef LMMS_DRUM_SYNTH_H
 #define LMMS_DRUM_SYNTH_H
 
+#include <map>
 #include <stdint.h>
+#include <string>
 
 #include "lmms_basics.h"
 
@@ -44,14 +46,18 @@ private:
 	float LoudestEnv();
 	int LongestEnv();
 	void UpdateEnv(int e, long t);
-	void GetEnv(int env, const char* sec, const char* key, QString ini);
+	void GetEnv(int env, const char* sec, const char* key);
 
 	float waveform(float ph, int form);
 
-	int GetPrivateProfileString(
-		const char* sec, const char* key, const char* def, char* buffer, int size, QString file);
-	int GetPrivateProfileInt(const char* sec, const char* key, int def, QString file);
-	float GetPrivateProfileFloat(const char* sec, const char* key, float def, QString file);
+	//! Reads all settings of @p file, which are then looked up by the GetPrivateProfile functions
+	bool LoadProfile(const QString& file);
+	int GetPrivateProfileString(const char* sec, const char* key, const char* def, char* buffer, int size);
+	int GetPrivateProfileInt(const char* sec, const char* key, int def);
+	float GetPrivateProfileFloat(const char* sec, const char* key, float def);
+
+	//! Values by lower case section and key names
+	std::map<std::string, std::map<std::string, std::string>> m_profile;
 };
 
 } // namespace lmms
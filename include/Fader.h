@@ -128,6 +128,8 @@ private:
 	}
 
 	void setPeak(float fPeak, float& targetPeak, float& persistentPeak, QElapsedTimer& lastPeakTimer);
+	//! Returns the window coordinate at which a level of @p peak is drawn
+	int peakToY(float peak) const;
 
 	void updateTextFloat();
 
@@ -160,6 +160,10 @@ struct ControlPortBase : public VisitablePort<ControlPortBase, PortBase>
 	//! lv2 defines scale points as
 	//! "single float Points (for control inputs)"
 	std::vector<float> m_scalePointMap;
+
+	//! Whether the model was driven by a controller or linked models
+	//! when its value was last copied to the plugin
+	bool m_wasControlled = false;
 };
 
 struct Control : public VisitablePort<Control, ControlPortBase>
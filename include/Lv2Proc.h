@@ -56,6 +56,8 @@ namespace Lv2Ports
 	struct Audio;
 	struct PortBase;
 	struct AtomSeq;
+	struct Control;
+	struct Cv;
 
 	enum class Type;
 	enum class Flow;
@@ -188,6 +190,13 @@ private:
 	// quick reference to specific, unique ports
 	StereoPortRef m_inPorts, m_outPorts;
 	Lv2Ports::AtomSeq *m_midiIn = nullptr, *m_midiOut = nullptr;
+	// input ports which copyModelsFromCore() must feed, so it does not need
+	// to visit all ports each period
+	std::vector<Lv2Ports::Control*> m_controlInputs;
+	std::vector<Lv2Ports::Cv*> m_cvInputs;
+	std::vector<Lv2Ports::AtomSeq*> m_atomInputs;
+	//! copy all control values on the next run, even unchanged ones
+	bool m_syncAllControls = true;
 
 	// MIDI
 	// many things here may be moved into the `Instrument` class
@@ -25,6 +25,8 @@
 #ifndef LMMS_GUI_MAIN_WINDOW_H
 #define LMMS_GUI_MAIN_WINDOW_H
 
+#include <future>
+
 #include <QBasicTimer>
 #include <QTimer>
 #include <QList>
@@ -228,6 +230,10 @@ private:
 	QBasicTimer m_updateTimer;
 	QTimer m_autoSaveTimer;
 	int m_autoSaveInterval;
+	//! Result of the autosave being written in the background
+	std::future<bool> m_autoSaveResult;
+
+	void waitForAutoSave();
 
 	friend class GuiApplication;
 
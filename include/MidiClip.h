@@ -26,6 +26,8 @@
 #ifndef LMMS_MIDI_CLIP_H
 #define LMMS_MIDI_CLIP_H
 
+#include <set>
+
 #include "Clip.h"
 #include "Note.h"
 
@@ -58,10 +60,13 @@ public:
 
 	void init();
 
+	//! Call after changing notes returned by notes() directly
 	void updateLength();
 
 	// note management
 	Note * addNote( const Note & _new_note, const bool _quant_pos = true );
+	//! Adds all @p notes at once, updating the clip only once, e.g. when importing
+	void addNotes(const std::vector<Note>& notes);
 
 	NoteVector::const_iterator removeNote(NoteVector::const_iterator it);
 	NoteVector::const_iterator removeNote(Note* note);
@@ -79,6 +84,11 @@ public:
 	Note * addStepNote( int step );
 	void setStep( int step, bool enabled );
 
+	inline int steps() const
+	{
+		return m_steps;
+	}
+
 	// Split the list of notes on the given position
 	void splitNotes(const NoteVector& notes, TimePos pos);
 
@@ -133,6 +143,11 @@ private:
 	void setType( Type _new_clip_type );
 	void checkType();
 
+	void addNoteExtents(const Note* note);
+	void removeNoteExtents(const Note* note);
+	void syncNoteExtents();
+	void applyNoteExtents();
+
 	void resizeToFirstTrack();
 
 	InstrumentTrack * m_instrumentTrack;
@@ -143,6 +158,12 @@ private:
 	NoteVector m_notes;
 	int m_steps;
 
+	// The extents of the notes, maintained on insertion and removal so the
+	// length does not have to be computed from all notes on every edit
+	std::multiset<tick_t> m_noteEnds; //!< end positions of notes with a length
+	std::multiset<tick_t> m_stepPositions; //!< positions of step notes
+	bool m_noteExtentsDirty = true;
+
 	MidiClip * adjacentMidiClipByOffset(int offset) const;
 
 	friend class gui::MidiClipView;
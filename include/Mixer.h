@@ -54,8 +54,13 @@ class MixerChannel : public ThreadableJob
 		// set to true if any effect in the channel is enabled and running
 		bool m_stillRunning;
 
-		float m_peakLeft;
-		float m_peakRight;
+		//! Called by the audio thread with the peaks of the processed period
+		void updatePeaks(float left, float right);
+		//! Return the highest peaks since the last call, or -1 if the channel
+		//! has not been processed since. Lock-free, meant for the meters in the GUI.
+		float takePeakLeft() { return m_peakLeft.exchange(-1.f, std::memory_order_relaxed); }
+		float takePeakRight() { return m_peakRight.exchange(-1.f, std::memory_order_relaxed); }
+
 		sampleFrame * m_buffer;
 		bool m_muteBeforeSolo;
 		BoolModel m_muteModel;
@@ -87,6 +92,9 @@ class MixerChannel : public ThreadableJob
 		void doProcessing() override;
 
 		std::optional<QColor> m_color;
+
+		std::atomic<float> m_peakLeft;
+		std::atomic<float> m_peakRight;
 };
 
 class MixerRoute : public QObject
@@ -68,6 +68,7 @@ protected:
 
 protected slots:
 	void updateAudioBuffer( const lmms::surroundSampleFrame * buffer );
+	void periodicUpdate();
 
 private:
 	bool clips(float level) const;
@@ -78,6 +79,9 @@ private:
 
 	sampleFrame * m_buffer;
 	bool m_active;
+	//! whether the buffer changed since it was drawn the last time
+	bool m_needsRepaint;
+	bool m_bufferSilent;
 
 	QColor m_leftChannelColor;
 	QColor m_rightChannelColor;
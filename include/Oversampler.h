@@ -0,0 +1,300 @@
+/*
+ * Oversampler.h - stereo oversampling with polyphase IIR half-band filters
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_OVERSAMPLER_H
+#define LMMS_OVERSAMPLER_H
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "hiir/PolyphaseIir2Designer.h"
+
+#if defined(__SSE__)
+#include "hiir/Downsampler2xSse.h"
+#include "hiir/Upsampler2xSse.h"
+#elif defined(__ARM_NEON)
+#include "hiir/Downsampler2xNeon.h"
+#include "hiir/Upsampler2xNeon.h"
+#else
+#include "hiir/Downsampler2xFpu.h"
+#include "hiir/Upsampler2xFpu.h"
+#endif
+
+#include "lmms_basics.h"
+
+namespace lmms
+{
+
+/**
+ * Stereo oversampler made of cascaded 2x polyphase IIR half-band stages,
+ * using the hiir library. Users of this header have to link against hiir.
+ *
+ * The stage next to the original sample rate has to keep the full audio band,
+ * so it is the steepest one. All further stages only see content below the
+ * original Nyquist frequency and get away with much cheaper filters.
+ *
+ * The filters of a channel are computed in parallel with SSE or NEON where
+ * available. The polyphase filters are minimum phase, so a dry signal mixed
+ * with the processed one would comb filter. downsampleDry() decimates the
+ * unprocessed signal through a second set of decimators to give it the same
+ * phase response.
+ *
+ * Usage per period:
+ *   sampleFrame* os = oversampler.upsample(buf, frames);
+ *   oversampler.downsampleDry(dry, frames); // optional
+ *   // process frames * oversampler.factor() frames in os
+ *   oversampler.downsample(buf, frames);
+ */
+class Oversampler
+{
+public:
+	static constexpr int MaxStages = 4; //!< up to 16x
+
+	Oversampler(int stages, fpp_t maxFrames) :
+		m_maxFrames(maxFrames),
+		m_buffer(static_cast<std::size_t>(maxFrames) << MaxStages)
+	{
+		for (auto& channel : m_work)
+		{
+			for (auto& work : channel)
+			{
+				work.resize(static_cast<std::size_t>(maxFrames) << MaxStages);
+			}
+		}
+
+		std::array<double, SteepCoefs> steep;
+		hiir::PolyphaseIir2Designer::compute_coefs_spec_order_tbw(steep.data(), SteepCoefs, SteepTransition);
+		std::array<double, RelaxedCoefs> relaxed;
+		hiir::PolyphaseIir2Designer::compute_coefs_spec_order_tbw(relaxed.data(), RelaxedCoefs, RelaxedTransition);
+
+		for (int ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+		{
+			m_steepUp[ch].set_coefs(steep.data());
+			for (int s = 0; s < MaxStages - 1; ++s)
+			{
+				m_relaxedUp[s][ch].set_coefs(relaxed.data());
+			}
+		}
+		m_down.setCoefs(steep.data(), relaxed.data());
+		m_dryDown.setCoefs(steep.data(), relaxed.data());
+
+		setStages(stages);
+	}
+
+	//! Sets the number of 2x stages, the oversampling factor being 2^stages
+	void setStages(int stages)
+	{
+		stages = std::clamp(stages, 0, MaxStages);
+		if (stages != m_stages)
+		{
+			m_stages = stages;
+			reset();
+		}
+	}
+
+	int stages() const { return m_stages; }
+	int factor() const { return 1 << m_stages; }
+
+	//! Clears the filter states, e.g. after a discontinuity in the input
+	void reset()
+	{
+		for (int ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+		{
+			m_steepUp[ch].clear_buffers();
+			for (int s = 0; s < MaxStages - 1; ++s)
+			{
+				m_relaxedUp[s][ch].clear_buffers();
+			}
+		}
+		m_down.clear();
+		m_dryDown.clear();
+		m_dryActive = false;
+	}
+
+	//! Upsamples @p frames frames of @p in and returns the internal buffer holding
+	//! frames * factor() frames. The buffer stays valid until the next call.
+	sampleFrame* upsample(const sampleFrame* in, fpp_t frames)
+	{
+		frames = std::min(frames, m_maxFrames);
+		// the dry decimators have to start over if they missed a period
+		m_dryActive = m_dryActive && m_dryCalled;
+		m_dryCalled = false;
+		if (m_stages == 0)
+		{
+			std::copy(in, in + frames, m_buffer.begin());
+			return m_buffer.data();
+		}
+
+		for (int ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+		{
+			float* src = m_work[ch][0].data();
+			float* dst = m_work[ch][1].data();
+			for (fpp_t f = 0; f < frames; ++f)
+			{
+				src[f] = in[f][ch];
+			}
+
+			long count = frames;
+			m_steepUp[ch].process_block(dst, src, count);
+			count *= 2;
+			for (int s = 0; s < m_stages - 1; ++s)
+			{
+				std::swap(src, dst);
+				m_relaxedUp[s][ch].process_block(dst, src, count);
+				count *= 2;
+			}
+
+			for (long f = 0; f < count; ++f)
+			{
+				m_buffer[f][ch] = dst[f];
+			}
+		}
+		return m_buffer.data();
+	}
+
+	//! Downsamples the internal buffer returned by upsample() into @p out,
+	//! which receives @p frames frames
+	void downsample(sampleFrame* out, fpp_t frames)
+	{
+		m_down.process(m_buffer.data(), out, std::min(frames, m_maxFrames), m_stages, m_work);
+	}
+
+	//! Downsamples the internal buffer returned by upsample() before it gets
+	//! processed. Its phase then matches the signal returned by downsample().
+	//! The decimators only run while this is called every period, and start
+	//! from silence otherwise.
+	void downsampleDry(sampleFrame* out, fpp_t frames)
+	{
+		if (!m_dryActive)
+		{
+			m_dryDown.clear();
+			m_dryActive = true;
+		}
+		m_dryCalled = true;
+		m_dryDown.process(m_buffer.data(), out, std::min(frames, m_maxFrames), m_stages, m_work);
+	}
+
+private:
+	// The passband of the first stage reaches 0.46 * fs, i.e. past 20 kHz at 44.1 kHz
+	static constexpr int SteepCoefs = 12;
+	static constexpr double SteepTransition = 0.04;
+	// Later stages only need to pass content below a quarter of their input rate
+	static constexpr int RelaxedCoefs = 4;
+	static constexpr double RelaxedTransition = 0.24;
+
+#if defined(__SSE__)
+	template<int Coefs> using Upsampler2x = hiir::Upsampler2xSse<Coefs>;
+	template<int Coefs> using Downsampler2x = hiir::Downsampler2xSse<Coefs>;
+#elif defined(__ARM_NEON)
+	template<int Coefs> using Upsampler2x = hiir::Upsampler2xNeon<Coefs>;
+	template<int Coefs> using Downsampler2x = hiir::Downsampler2xNeon<Coefs>;
+#else
+	template<int Coefs> using Upsampler2x = hiir::Upsampler2xFpu<Coefs>;
+	template<int Coefs> using Downsampler2x = hiir::Downsampler2xFpu<Coefs>;
+#endif
+
+	//! Planar ping-pong buffers per channel, so the filters run on contiguous blocks
+	using WorkBuffers = std::array<std::array<std::vector<float>, 2>, DEFAULT_CHANNELS>;
+
+	//! The decimating stages of both channels
+	struct Decimator
+	{
+		std::array<Downsampler2x<SteepCoefs>, DEFAULT_CHANNELS> steep;
+		std::array<std::array<Downsampler2x<RelaxedCoefs>, DEFAULT_CHANNELS>, MaxStages - 1> relaxed;
+
+		void setCoefs(const double* steepCoefs, const double* relaxedCoefs)
+		{
+			for (int ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+			{
+				steep[ch].set_coefs(steepCoefs);
+				for (int s = 0; s < MaxStages - 1; ++s)
+				{
+					relaxed[s][ch].set_coefs(relaxedCoefs);
+				}
+			}
+		}
+
+		void clear()
+		{
+			for (int ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+			{
+				steep[ch].clear_buffers();
+				for (int s = 0; s < MaxStages - 1; ++s)
+				{
+					relaxed[s][ch].clear_buffers();
+				}
+			}
+		}
+
+		void process(const sampleFrame* in, sampleFrame* out, fpp_t frames, int stages, WorkBuffers& work)
+		{
+			if (stages == 0)
+			{
+				std::copy(in, in + frames, out);
+				return;
+			}
+
+			for (int ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+			{
+				float* src = work[ch][0].data();
+				float* dst = work[ch][1].data();
+				long count = static_cast<long>(frames) << stages;
+				for (long f = 0; f < count; ++f)
+				{
+					src[f] = in[f][ch];
+				}
+
+				for (int s = stages - 2; s >= 0; --s)
+				{
+					count /= 2;
+					relaxed[s][ch].process_block(dst, src, count);
+					std::swap(src, dst);
+				}
+				steep[ch].process_block(dst, src, frames);
+
+				for (fpp_t f = 0; f < frames; ++f)
+				{
+					out[f][ch] = dst[f];
+				}
+			}
+		}
+	};
+
+	fpp_t m_maxFrames;
+	int m_stages = -1;
+
+	std::array<Upsampler2x<SteepCoefs>, DEFAULT_CHANNELS> m_steepUp;
+	std::array<std::array<Upsampler2x<RelaxedCoefs>, DEFAULT_CHANNELS>, MaxStages - 1> m_relaxedUp;
+	Decimator m_down;
+	Decimator m_dryDown;
+	bool m_dryActive = false; //!< whether the dry decimators hold the state of the last period
+	bool m_dryCalled = false; //!< whether downsampleDry() was called since the last upsample()
+
+	WorkBuffers m_work;
+	//! Interleaved oversampled signal handed to the effect
+	std::vector<sampleFrame> m_buffer;
+};
+
+} // namespace lmms
+
+#endif // LMMS_OVERSAMPLER_H
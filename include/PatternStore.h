@@ -25,6 +25,9 @@
 #ifndef LMMS_PATTERN_STORE_H
 #define LMMS_PATTERN_STORE_H
 
+#include <atomic>
+#include <vector>
+
 #include "TrackContainer.h"
 #include "ComboBoxModel.h"
 
@@ -79,6 +82,8 @@ public:
 	}
 
 	bar_t lengthOfPattern(int pattern) const;
+	//! Same as lengthOfPattern(), but cached. Only to be used from the audio thread.
+	bar_t playbackLengthOfPattern(int pattern) const;
 	inline bar_t lengthOfCurrentPattern()
 	{
 		return lengthOfPattern(currentPattern());
@@ -102,8 +107,24 @@ public slots:
 
 
 private:
+	//! What playing a pattern needs to know, cached so it does not have to be gathered on every tick
+	struct PatternPlaybackInfo
+	{
+		bar_t length;
+		//! Tracks that have a clip for the pattern
+		std::vector<Track*> tracks;
+	};
+
+	void connectTrack(Track* track);
+	void connectClip(Clip* clip);
+	void invalidatePlaybackInfo();
+	const PatternPlaybackInfo* playbackInfo(int pattern) const;
+
 	ComboBoxModel m_patternComboBoxModel;
 
+	mutable std::vector<PatternPlaybackInfo> m_playbackInfo;
+	mutable std::atomic<bool> m_playbackInfoDirty;
+
 
 	// Where the pattern selection combo box is
 	friend class gui::PatternEditorWindow;
@@ -62,6 +62,7 @@ public:
 private:
 	static PreviewTrackContainer* s_previewTC;
 
+	InstrumentTrack* m_previewTrack;
 	NotePlayHandle* m_previewNote;
 
 } ;
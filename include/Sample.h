@@ -68,6 +68,15 @@ public:
 		void setVaryingPitch(bool varyingPitch) { m_varyingPitch = varyingPitch; }
 		void setBackwards(bool backwards) { m_backwards = backwards; }
 
+		//! Prepares the state for playing another note from the start
+		void reset(bool varyingPitch)
+		{
+			m_resampler.reset();
+			m_frameIndex = 0;
+			m_varyingPitch = varyingPitch;
+			m_backwards = false;
+		}
+
 	private:
 		AudioResampler m_resampler;
 		int m_frameIndex = 0;
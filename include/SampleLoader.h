@@ -26,6 +26,7 @@
 #define LMMS_GUI_SAMPLE_LOADER_H
 
 #include <QString>
+#include <QStringList>
 #include <memory>
 
 #include "SampleBuffer.h"
@@ -40,6 +41,11 @@ public:
 	static std::shared_ptr<const SampleBuffer> createBufferFromFile(const QString& filePath);
 	static std::shared_ptr<const SampleBuffer> createBufferFromBase64(
 		const QString& base64, int sampleRate = Engine::audioEngine()->outputSampleRate());
+
+	//! Decodes @p filePaths in parallel. Until releasePreloadedBuffers() is called,
+	//! createBufferFromFile() returns these buffers instead of decoding the files again.
+	static void preloadFiles(const QStringList& filePaths);
+	static void releasePreloadedBuffers();
 private:
 	static void displayError(const QString& message);
 };
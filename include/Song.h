@@ -43,6 +43,7 @@ namespace lmms
 {
 
 class AutomationTrack;
+class DataFile;
 class Keymap;
 class MidiClip;
 class Scale;
@@ -302,6 +303,9 @@ public:
 	bool guiSaveProject();
 	bool guiSaveProjectAs(const QString & filename);
 	bool saveProjectFile(const QString & filename, bool withResources = false);
+	//! Stores the whole project in @p dataFile, which can then be written
+	//! independently of the song, e.g. from another thread
+	void saveProject(DataFile & dataFile);
 
 	const QString & projectFileName() const
 	{
@@ -0,0 +1,62 @@
+/*
+ * ThreadPolicy.h - scheduling, CPU placement and memory locking per thread role
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_THREAD_POLICY_H
+#define LMMS_THREAD_POLICY_H
+
+#include "lmms_export.h"
+
+/**
+ * Every thread of LMMS declares its role once it runs, and the policy decides
+ * how it is scheduled. Only the threads computing the audio of a live session
+ * and the threads writing it to the sound card get real-time priority, so the
+ * GUI, loaders and the export encoder cannot preempt them, and nothing they
+ * spawn inherits it.
+ *
+ * The behaviour is configured in the "audioengine" section of the config file:
+ *   realtime    - 0 disables real-time scheduling of render threads (default 1)
+ *   cpupinning  - comma separated CPUs the render threads are pinned to, round-robin
+ *   isolatecpus - 1 keeps all other threads off the pinned CPUs (default 0)
+ *   lockmemory  - 1 locks the process memory and prefaults render thread stacks (default 0)
+ */
+namespace lmms::ThreadPolicy
+{
+	enum class Role
+	{
+		AudioWorker, //!< AudioEngineWorkerThread
+		FifoWriter, //!< Thread driving the audio engine for a live audio device
+		DeviceIo, //!< Thread of an audio device writing the rendered audio to the sound card
+		Gui, //!< The main thread
+		Loader, //!< Threads loading projects, samples or plugins
+		Encoder //!< Thread rendering and encoding an export
+	};
+
+	//! Applies the policy of @p role to the calling thread. @p index tells apart
+	//! threads of the same role, e.g. to pin them to different CPUs.
+	void LMMS_EXPORT applyToCurrentThread(Role role, int index = 0);
+
+	//! Locks the current and future memory of the process if enabled,
+	//! to be called once at startup
+	void LMMS_EXPORT lockMemory();
+}
+
+#endif // LMMS_THREAD_POLICY_H
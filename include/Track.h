@@ -25,6 +25,7 @@
 #ifndef LMMS_TRACK_H
 #define LMMS_TRACK_H
 
+#include <atomic>
 #include <vector>
 
 #include <QColor>
@@ -226,6 +227,24 @@ private:
 
 	clipVector m_clips;
 
+	//! Entry of the clip index, which is sorted by start position
+	struct IndexedClip
+	{
+		tick_t start;
+		tick_t end;
+		tick_t maxEnd; //!< latest end of this and all preceding entries
+		Clip* clip;
+	};
+
+	void invalidateClipIndex();
+	void updateClipIndex();
+
+	std::vector<IndexedClip> m_clipIndex;
+	std::atomic<bool> m_clipIndexDirty;
+	//! First index entry that may still overlap the range of the last lookup
+	std::size_t m_clipIndexCursor;
+	tick_t m_clipIndexCursorTime;
+
 	QMutex m_processingLock;
 	
 	std::optional<QColor> m_color;
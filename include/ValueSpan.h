@@ -0,0 +1,169 @@
+/*
+ * ValueSpan.h - per-period snapshots of model values for audio processing loops
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_VALUE_SPAN_H
+#define LMMS_VALUE_SPAN_H
+
+#include "AutomatableModel.h"
+#include "ValueBuffer.h"
+#include "lmms_basics.h"
+
+namespace lmms
+{
+
+
+/**
+ * The values of a FloatModel for one period, taken at the start of processing.
+ *
+ * If the model has sample-exact data (automation, controllers), the span refers
+ * to its ValueBuffer, otherwise it holds the model's constant value. Indexing is
+ * branch-free in both cases, so processing loops using spans can be vectorized:
+ *
+ *   const auto gain = ValueSpan{m_controls.m_gainModel};
+ *   for (fpp_t f = 0; f < frames; ++f) { buf[f][0] *= gain[f]; ... }
+ */
+class ValueSpan
+{
+public:
+	explicit ValueSpan(FloatModel& model)
+	{
+		if (const ValueBuffer* buffer = model.valueBuffer())
+		{
+			setValues(buffer->values());
+		}
+		else
+		{
+			setConstant(model.value());
+		}
+	}
+
+	explicit ValueSpan(float value = 0.f)
+	{
+		setConstant(value);
+	}
+
+	ValueSpan(const ValueSpan& other)
+	{
+		*this = other;
+	}
+
+	ValueSpan& operator=(const ValueSpan& other)
+	{
+		if (other.isConstant()) { setConstant(other.m_constant); }
+		else { setValues(other.m_values); }
+		return *this;
+	}
+
+	float operator[](fpp_t frame) const
+	{
+		return m_values[frame * m_stride];
+	}
+
+	bool isConstant() const
+	{
+		return m_stride == 0;
+	}
+
+	void setConstant(float value)
+	{
+		m_constant = value;
+		m_values = &m_constant;
+		m_stride = 0;
+	}
+
+	//! Refers to @p values, which must hold at least one value per frame of the period
+	void setValues(const float* values)
+	{
+		m_values = values;
+		m_stride = 1;
+	}
+
+private:
+	const float* m_values;
+	int m_stride;
+	float m_constant;
+};
+
+
+/**
+ * Like ValueSpan, but a value that changed since the previous period without
+ * sample-exact data is ramped linearly across the period instead of jumping,
+ * which avoids zipper noise on gains and similar parameters.
+ *
+ * Keep one instance per parameter in the effect, as it remembers the last value.
+ */
+class SmoothedValueSpan
+{
+public:
+	SmoothedValueSpan(fpp_t maxFrames, float initialValue = 0.f) :
+		m_ramp(maxFrames),
+		m_last(initialValue)
+	{
+	}
+
+	//! Takes the snapshot of @p model for the current period
+	const ValueSpan& update(FloatModel& model, fpp_t frames)
+	{
+		if (const ValueBuffer* buffer = model.valueBuffer())
+		{
+			m_span.setValues(buffer->values());
+			m_last = buffer->value(frames - 1);
+			return m_span;
+		}
+		return update(model.value(), frames);
+	}
+
+	//! Takes the snapshot of a value derived from models, e.g. a gain in dB converted to amplitude
+	const ValueSpan& update(float value, fpp_t frames)
+	{
+		if (value == m_last || frames > m_ramp.length())
+		{
+			m_span.setConstant(value);
+		}
+		else
+		{
+			const float step = (value - m_last) / frames;
+			for (fpp_t f = 0; f < frames; ++f)
+			{
+				m_ramp[f] = m_last + step * (f + 1);
+			}
+			m_span.setValues(m_ramp.values());
+		}
+		m_last = value;
+		return m_span;
+	}
+
+	const ValueSpan& span() const
+	{
+		return m_span;
+	}
+
+private:
+	ValueBuffer m_ramp;
+	ValueSpan m_span;
+	float m_last;
+};
+
+
+} // namespace lmms
+
+#endif // LMMS_VALUE_SPAN_H
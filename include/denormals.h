@@ -4,6 +4,8 @@
 #ifndef LMMS_DENORMALS_H
 #define LMMS_DENORMALS_H
 
+#include <cstdint>
+
 #ifdef __SSE__
 #include <immintrin.h>
 #ifdef __GNUC__
@@ -11,6 +13,14 @@
 #endif // __GNUC__
 #endif // __SSE__
 
+// Arm Architecture Reference Manual: bit 24 (FZ) of the FPCR (AArch64)
+// or the FPSCR (AArch32) flushes denormal inputs and results to zero
+#if defined(__aarch64__) && defined(__GNUC__)
+#define LMMS_DENORMALS_FPCR
+#elif defined(__arm__) && defined(__ARM_FP) && defined(__GNUC__)
+#define LMMS_DENORMALS_FPSCR
+#endif
+
 
 namespace lmms
 {
@@ -23,11 +33,13 @@ namespace lmms
 int inline can_we_daz()
 {
   alignas(16) unsigned char buffer[512] = {0};
-#if defined(LMMS_HOST_X86)
-  _fxsave(buffer);
-#elif defined(LMMS_HOST_X86_64)
+  // Check what we are compiled for rather than the host of the main
+  // build, as 32 bit remote plugins are built on 64 bit hosts
+#if defined(__x86_64__) || defined(_M_X64)
   _fxsave64(buffer);
-#endif // defined(LLMS_HOST_X86)
+#else
+  _fxsave(buffer);
+#endif
   // Bit 6 of the MXCSR_MASK, i.e. in the lowest byte,
   // tells if we can use the DAZ flag.
   return ((buffer[28] & (1 << 6)) != 0);
@@ -35,6 +47,47 @@ int inline can_we_daz()
 
 #endif // __SSE__
 
+#if defined(LMMS_DENORMALS_FPCR)
+
+constexpr std::uint64_t FPCR_FZ = 1 << 24;
+
+std::uint64_t inline read_fpcr()
+{
+  std::uint64_t fpcr;
+  asm volatile("mrs %0, fpcr" : "=r"(fpcr));
+  return fpcr;
+}
+
+void inline write_fpcr(std::uint64_t fpcr)
+{
+  asm volatile("msr fpcr, %0" : : "r"(fpcr));
+}
+
+#elif defined(LMMS_DENORMALS_FPSCR)
+
+constexpr std::uint32_t FPCR_FZ = 1 << 24;
+
+std::uint32_t inline read_fpcr()
+{
+  std::uint32_t fpscr;
+  asm volatile("vmrs %0, fpscr" : "=r"(fpscr));
+  return fpscr;
+}
+
+void inline write_fpcr(std::uint32_t fpscr)
+{
+  asm volatile("vmsr fpscr, %0" : : "r"(fpscr));
+}
+
+#endif
+
+// Whether disable_denormals() has any effect on this architecture
+#if defined(__SSE__) || defined(LMMS_DENORMALS_FPCR) || defined(LMMS_DENORMALS_FPSCR)
+constexpr bool CAN_FLUSH_DENORMALS = true;
+#else
+constexpr bool CAN_FLUSH_DENORMALS = false;
+#endif
+
 // Set denormal protection for this thread.
 void inline disable_denormals()
 {
@@ -45,7 +98,34 @@ void inline disable_denormals()
   }
   /* FTZ flag */
   _MM_SET_FLUSH_ZERO_MODE( _MM_FLUSH_ZERO_ON );
-#endif // __SSE__
+#elif defined(LMMS_DENORMALS_FPCR) || defined(LMMS_DENORMALS_FPSCR)
+  write_fpcr(read_fpcr() | FPCR_FZ);
+#endif
+}
+
+// Whether denormal results are flushed to zero in this thread.
+bool inline denormals_are_flushed()
+{
+#ifdef __SSE__
+  return _MM_GET_FLUSH_ZERO_MODE() == _MM_FLUSH_ZERO_ON;
+#elif defined(LMMS_DENORMALS_FPCR) || defined(LMMS_DENORMALS_FPSCR)
+  return (read_fpcr() & FPCR_FZ) != 0;
+#else
+  return false;
+#endif
+}
+
+// To be applied to the state of recursive filters. Where denormals can't be
+// flushed, a tiny offset far below audibility keeps a decaying state from
+// becoming denormal. Elsewhere, this does nothing.
+template<typename T>
+T inline denormal_guard(T state)
+{
+  if constexpr (CAN_FLUSH_DENORMALS) {
+    return state;
+  } else {
+    return state + static_cast<T>(1e-20);
+  }
 }
 
 } // namespace lmms
@@ -25,6 +25,7 @@
 
 #include "Amplifier.h"
 
+#include "ValueSpan.h"
 #include "embed.h"
 #include "plugin_export.h"
 
@@ -65,17 +66,17 @@ bool AmplifierEffect::processAudioBuffer(sampleFrame* buf, const fpp_t frames)
 	const float d = dryLevel();
 	const float w = wetLevel();
 
-	const ValueBuffer* volumeBuf = m_ampControls.m_volumeModel.valueBuffer();
-	const ValueBuffer* panBuf = m_ampControls.m_panModel.valueBuffer();
-	const ValueBuffer* leftBuf = m_ampControls.m_leftModel.valueBuffer();
-	const ValueBuffer* rightBuf = m_ampControls.m_rightModel.valueBuffer();
+	const auto volumeSpan = ValueSpan{m_ampControls.m_volumeModel};
+	const auto panSpan = ValueSpan{m_ampControls.m_panModel};
+	const auto leftSpan = ValueSpan{m_ampControls.m_leftModel};
+	const auto rightSpan = ValueSpan{m_ampControls.m_rightModel};
 
 	for (fpp_t f = 0; f < frames; ++f)
 	{
-		const float volume = (volumeBuf ? volumeBuf->value(f) : m_ampControls.m_volumeModel.value()) * 0.01f;
-		const float pan = (panBuf ? panBuf->value(f) : m_ampControls.m_panModel.value()) * 0.01f;
-		const float left = (leftBuf ? leftBuf->value(f) : m_ampControls.m_leftModel.value()) * 0.01f;
-		const float right = (rightBuf ? rightBuf->value(f) : m_ampControls.m_rightModel.value()) * 0.01f;
+		const float volume = volumeSpan[f] * 0.01f;
+		const float pan = panSpan[f] * 0.01f;
+		const float left = leftSpan[f] * 0.01f;
+		const float right = rightSpan[f] * 0.01f;
 
 		const float panLeft = std::min(1.0f, 1.0f - pan);
 		const float panRight = std::min(1.0f, 1.0f + pan);
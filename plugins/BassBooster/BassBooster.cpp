@@ -24,6 +24,7 @@
 
 #include "BassBooster.h"
 
+#include "ValueSpan.h"
 #include "embed.h"
 #include "plugin_export.h"
 
@@ -84,8 +85,7 @@ bool BassBoosterEffect::processAudioBuffer( sampleFrame* buf, const fpp_t frames
 	if( m_bbControls.m_gainModel.isValueChanged() ) { changeGain(); }
 	if( m_bbControls.m_ratioModel.isValueChanged() ) { changeRatio(); }
 
-	const float const_gain = m_bbControls.m_gainModel.value();
-	const ValueBuffer *gainBuffer = m_bbControls.m_gainModel.valueBuffer();
+	const auto gain = ValueSpan{ m_bbControls.m_gainModel };
 
 	double outSum = 0.0;
 	const float d = dryLevel();
@@ -93,14 +93,8 @@ bool BassBoosterEffect::processAudioBuffer( sampleFrame* buf, const fpp_t frames
 
 	for( fpp_t f = 0; f < frames; ++f )
 	{
-		float gain = const_gain;
-		if (gainBuffer) {
-			//process period using sample exact data
-			gain = gainBuffer->value( f );
-		}
-		//float gain = gainBuffer ? gainBuffer[f] : gain;
-		m_bbFX.leftFX().setGain( gain );
-		m_bbFX.rightFX().setGain( gain);
+		m_bbFX.leftFX().setGain( gain[f] );
+		m_bbFX.rightFX().setGain( gain[f] );
 
 		auto s = std::array{buf[f][0], buf[f][1]};
 		m_bbFX.nextSample( s[0], s[1] );
@@ -31,12 +31,8 @@ namespace lmms
 {
 
 
-const int OS_RATE = 5;
-const float OS_RATIO = 1.0f / OS_RATE;
-const float CUTOFF_RATIO = 0.353553391f;
-const int SILENCEFRAMES = 10;
-const auto OS_RESAMPLE = std::array{0.0001490062883964112f, 0.1645978376763992f, 0.6705063120704088f,
-		0.1645978376763992f, 0.0001490062883964112f };
+// 2^2 = 4x oversampling
+const int OS_STAGES = 2;
 
 extern "C"
 {
@@ -59,11 +55,11 @@ Plugin::Descriptor PLUGIN_EXPORT bitcrush_plugin_descriptor =
 BitcrushEffect::BitcrushEffect( Model * parent, const Descriptor::SubPluginFeatures::Key * key ) :
 	Effect( &bitcrush_plugin_descriptor, parent, key ),
 	m_controls( this ),
-	m_sampleRate( Engine::audioEngine()->outputSampleRate() ),
-	m_filter( m_sampleRate )
+	m_oversampler( OS_STAGES, Engine::audioEngine()->framesPerPeriod() ),
+	m_crushed( Engine::audioEngine()->framesPerPeriod() ),
+	m_dry( Engine::audioEngine()->framesPerPeriod() ),
+	m_sampleRate( Engine::audioEngine()->outputSampleRate() )
 {
-	m_buffer = new sampleFrame[Engine::audioEngine()->framesPerPeriod() * OS_RATE];
-	m_filter.setLowpass( m_sampleRate * ( CUTOFF_RATIO * OS_RATIO ) );
 	m_needsUpdate = true;
 
 	m_bitCounterL = 0.0f;
@@ -71,21 +67,13 @@ BitcrushEffect::BitcrushEffect( Model * parent, const Descriptor::SubPluginFeatu
 
 	m_left = 0.0f;
 	m_right = 0.0f;
-
-	m_silenceCounter = 0;
-}
-
-BitcrushEffect::~BitcrushEffect()
-{
-	delete[] m_buffer;
 }
 
 
 void BitcrushEffect::sampleRateChanged()
 {
 	m_sampleRate = Engine::audioEngine()->outputSampleRate();
-	m_filter.setSampleRate( m_sampleRate );
-	m_filter.setLowpass( m_sampleRate * ( CUTOFF_RATIO * OS_RATIO ) );
+	m_oversampler.reset();
 	m_needsUpdate = true;
 }
 
@@ -123,8 +111,8 @@ bool BitcrushEffect::processAudioBuffer( sampleFrame* buf, const fpp_t frames )
 		const float rate = m_controls.m_rate.value();
 		const float diff = m_controls.m_stereoDiff.value() * 0.005 * rate;
 
-		m_rateCoeffL = ( m_sampleRate * OS_RATE ) / ( rate - diff );
-		m_rateCoeffR = ( m_sampleRate * OS_RATE ) / ( rate + diff );
+		m_rateCoeffL = ( m_sampleRate * m_oversampler.factor() ) / ( rate - diff );
+		m_rateCoeffR = ( m_sampleRate * m_oversampler.factor() ) / ( rate + diff );
 
 		m_bitCounterL = 0.0f;
 		m_bitCounterR = 0.0f;
@@ -150,92 +138,67 @@ bool BitcrushEffect::processAudioBuffer( sampleFrame* buf, const fpp_t frames )
 
 	const float noiseAmt = m_controls.m_inNoise.value() * 0.01f;
 
-	// read input buffer and write it to oversampled buffer
+	// band-limited upsampling of the input, the crushing itself runs at the higher rate
+	sampleFrame* osBuf = m_oversampler.upsample( buf, frames );
+	const int osFrames = frames * m_oversampler.factor();
+
+	// the dry signal gets the phase shift of the oversampling filters too, so
+	// mixing it with the crushed signal doesn't comb filter
+	const float d = dryLevel();
+	const float w = wetLevel();
+	const sampleFrame* dry = buf;
+	if( d != 0.0f )
+	{
+		m_oversampler.downsampleDry( m_dry.data(), frames );
+		dry = m_dry.data();
+	}
+
 	if( m_rateEnabled ) // rate crushing enabled so do that
 	{
-		for( int f = 0; f < frames; ++f )
+		for( int f = 0; f < osFrames; ++f )
 		{
-			for( int o = 0; o < OS_RATE; ++o )
+			m_bitCounterL += 1.0f;
+			m_bitCounterR += 1.0f;
+			if( m_bitCounterL > m_rateCoeffL )
 			{
-				m_buffer[f * OS_RATE + o][0] = m_left;
-				m_buffer[f * OS_RATE + o][1] = m_right;
-				m_bitCounterL += 1.0f;
-				m_bitCounterR += 1.0f;
-				if( m_bitCounterL > m_rateCoeffL )
-				{
-					m_bitCounterL -= m_rateCoeffL;
-					m_left = m_depthEnabled
-						? depthCrush( buf[f][0] * m_inGain + noise( buf[f][0] * noiseAmt ) )
-						: buf[f][0] * m_inGain + noise( buf[f][0] * noiseAmt );
-				}
-				if( m_bitCounterR > m_rateCoeffR )
-				{
-					m_bitCounterR -= m_rateCoeffR;
-					m_right = m_depthEnabled
-						? depthCrush( buf[f][1] * m_inGain + noise( buf[f][1] * noiseAmt ) )
-						: buf[f][1] * m_inGain + noise( buf[f][1] * noiseAmt );
-				}
+				m_bitCounterL -= m_rateCoeffL;
+				m_left = m_depthEnabled
+					? depthCrush( osBuf[f][0] * m_inGain + noise( osBuf[f][0] * noiseAmt ) )
+					: osBuf[f][0] * m_inGain + noise( osBuf[f][0] * noiseAmt );
 			}
-		}
-	}
-	else // rate crushing disabled: simply oversample with zero-order hold
-	{
-		for( int f = 0; f < frames; ++f )
-		{
-			for( int o = 0; o < OS_RATE; ++o )
+			if( m_bitCounterR > m_rateCoeffR )
 			{
-				m_buffer[f * OS_RATE + o][0] = m_depthEnabled
-					? depthCrush( buf[f][0] * m_inGain + noise( buf[f][0] * noiseAmt ) )
-					: buf[f][0] * m_inGain + noise( buf[f][0] * noiseAmt );
-				m_buffer[f * OS_RATE + o][1] = m_depthEnabled
-					? depthCrush( buf[f][1] * m_inGain + noise( buf[f][1] * noiseAmt ) )
-					: buf[f][1] * m_inGain + noise( buf[f][1] * noiseAmt );
+				m_bitCounterR -= m_rateCoeffR;
+				m_right = m_depthEnabled
+					? depthCrush( osBuf[f][1] * m_inGain + noise( osBuf[f][1] * noiseAmt ) )
+					: osBuf[f][1] * m_inGain + noise( osBuf[f][1] * noiseAmt );
 			}
+			osBuf[f][0] = m_left;
+			osBuf[f][1] = m_right;
 		}
 	}
-
-	// the oversampled buffer is now written, so filter it to reduce aliasing
-
-	for( int f = 0; f < frames * OS_RATE; ++f )
+	else // rate crushing disabled
 	{
-		if( qMax( qAbs( m_buffer[f][0] ), qAbs( m_buffer[f][1] ) ) >= 1.0e-10f )
+		for( int f = 0; f < osFrames; ++f )
 		{
-			m_silenceCounter = 0;
-			m_buffer[f][0] = m_filter.update( m_buffer[f][0], 0 );
-			m_buffer[f][1] = m_filter.update( m_buffer[f][1], 1 );
-		}
-		else
-		{
-			if( m_silenceCounter > SILENCEFRAMES )
-			{
-				m_buffer[f][0] = m_buffer[f][1] = 0.0f;
-			}
-			else
-			{
-				++m_silenceCounter;
-				m_buffer[f][0] = m_filter.update( m_buffer[f][0], 0 );
-				m_buffer[f][1] = m_filter.update( m_buffer[f][1], 1 );
-			}
+			osBuf[f][0] = m_depthEnabled
+				? depthCrush( osBuf[f][0] * m_inGain + noise( osBuf[f][0] * noiseAmt ) )
+				: osBuf[f][0] * m_inGain + noise( osBuf[f][0] * noiseAmt );
+			osBuf[f][1] = m_depthEnabled
+				? depthCrush( osBuf[f][1] * m_inGain + noise( osBuf[f][1] * noiseAmt ) )
+				: osBuf[f][1] * m_inGain + noise( osBuf[f][1] * noiseAmt );
 		}
 	}
 
+	// the oversampled buffer is now written, so filter and decimate it
 
-	// now downsample and write it back to main buffer
+	m_oversampler.downsample( m_crushed.data(), frames );
 
 	double outSum = 0.0;
-	const float d = dryLevel();
-	const float w = wetLevel();
 	for( int f = 0; f < frames; ++f )
 	{
-		float lsum = 0.0f;
-		float rsum = 0.0f;
-		for( int o = 0; o < OS_RATE; ++o )
-		{
-			lsum += m_buffer[f * OS_RATE + o][0] * OS_RESAMPLE[o];
-			rsum += m_buffer[f * OS_RATE + o][1] * OS_RESAMPLE[o];
-		}
-		buf[f][0] = d * buf[f][0] + w * qBound( -m_outClip, lsum, m_outClip ) * m_outGain;
-		buf[f][1] = d * buf[f][1] + w * qBound( -m_outClip, rsum, m_outClip ) * m_outGain;
+		buf[f][0] = d * dry[f][0] + w * qBound( -m_outClip, m_crushed[f][0], m_outClip ) * m_outGain;
+		buf[f][1] = d * dry[f][1] + w * qBound( -m_outClip, m_crushed[f][1], m_outClip ) * m_outGain;
 		outSum += buf[f][0]*buf[f][0] + buf[f][1]*buf[f][1];
 	}
 
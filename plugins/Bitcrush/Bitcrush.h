@@ -27,9 +27,11 @@
 #ifndef BITCRUSH_H
 #define BITCRUSH_H
 
+#include <vector>
+
 #include "Effect.h"
 #include "BitcrushControls.h"
-#include "BasicFilters.h"
+#include "Oversampler.h"
 
 
 namespace lmms
@@ -40,7 +42,7 @@ class BitcrushEffect : public Effect
 {
 public:
 	BitcrushEffect( Model* parent, const Descriptor::SubPluginFeatures::Key* key );
-	~BitcrushEffect() override;
+	~BitcrushEffect() override = default;
 	bool processAudioBuffer( sampleFrame* buf, const fpp_t frames ) override;
 
 	EffectControls* controls() override
@@ -55,9 +57,10 @@ private:
 
 	BitcrushControls m_controls;
 	
-	sampleFrame * m_buffer;
+	Oversampler m_oversampler;
+	std::vector<sampleFrame> m_crushed;
+	std::vector<sampleFrame> m_dry;
 	float m_sampleRate;
-	StereoLinkwitzRiley m_filter;
 	
 	float m_bitCounterL;
 	float m_rateCoeffL;
@@ -77,8 +80,6 @@ private:
 	float m_outClip;
 
 	bool m_needsUpdate;
-	
-	int m_silenceCounter;
 
 	friend class BitcrushControls;
 };
@@ -155,6 +155,9 @@ CarlaInstrument::CarlaInstrument(InstrumentTrack* const instrumentTrack, const D
       fHandle(nullptr),
       fDescriptor(isPatchbay ? carla_get_native_patchbay_plugin() : carla_get_native_rack_plugin()),
       fMidiEventCount(0),
+      m_midiEventQueue(kMaxMidiEvents),
+      m_midiEventReader(m_midiEventQueue),
+      m_anyParamDirty(false),
       m_paramModels()
 {
     fHost.handle      = this;
@@ -207,11 +210,17 @@ CarlaInstrument::CarlaInstrument(InstrumentTrack* const instrumentTrack, const D
     // Add static amount of CarlaParamFloatModel's.
     int paramCount = fDescriptor->get_parameter_count(fHandle);
     m_paramModels.reserve(paramCount);
+    m_paramValues = std::vector<std::atomic<float>>(paramCount);
+    m_paramDirty.reset(new std::atomic<bool>[paramCount]);
     for (int i=0; i < paramCount; ++i)
     {
         m_paramModels.push_back(new CarlaParamFloatModel(this));
+        m_paramDirty[i] = false;
         connect(m_paramModels[i], &CarlaParamFloatModel::dataChanged,
             this, [this, i]() {paramModelChanged(i);}, Qt::DirectConnection);
+        // the UI is only updated from the GUI thread
+        connect(m_paramModels[i], &CarlaParamFloatModel::dataChanged,
+            this, [this, i]() {updateParamUi(i);});
     }
 #endif
 
@@ -451,19 +460,46 @@ void CarlaInstrument::clearParamModels()
 }
 
 void CarlaInstrument::paramModelChanged(uint32_t index)
-{ // Update Carla param (LMMS -> Carla)
-	if (!m_paramModels[index]->isOutput())
+{ // Update Carla param (LMMS -> Carla), done in the next play()
+	if (m_paramModels[index]->isOutput())
 	{
-		if (fDescriptor->set_parameter_value != nullptr)
-		{
-			fDescriptor->set_parameter_value(fHandle, index, m_paramModels[index]->value());
+		return;
+	}
 
-		}
+	m_paramValues[index].store(m_paramModels[index]->value(), std::memory_order_relaxed);
+	m_paramDirty[index].store(true, std::memory_order_release);
+	m_anyParamDirty.store(true, std::memory_order_release);
+}
+
+void CarlaInstrument::updateParamUi(uint32_t index)
+{
+	// the models may have been deleted in the meantime
+	if (index >= static_cast<uint32_t>(m_paramModels.count()) || m_paramModels[index]->isOutput())
+	{
+		return;
+	}
+
+	// TODO? Shouldn't Carla be doing this?
+	if (fDescriptor->ui_set_parameter_value != nullptr)
+	{
+		fDescriptor->ui_set_parameter_value(fHandle, index, m_paramModels[index]->value());
+	}
+}
 
-		// TODO? Shouldn't Carla be doing this?
-		if (fDescriptor->ui_set_parameter_value != nullptr)
+void CarlaInstrument::sendParamChanges()
+{
+	if (!m_anyParamDirty.exchange(false, std::memory_order_acquire)
+		|| fDescriptor->set_parameter_value == nullptr)
+	{
+		return;
+	}
+
+	for (uint32_t index = 0; index < m_paramValues.size(); ++index)
+	{
+		if (m_paramDirty[index].exchange(false, std::memory_order_acquire))
 		{
-			fDescriptor->ui_set_parameter_value(fHandle, index, m_paramModels[index]->value());
+			const float value = m_paramValues[index].load(std::memory_order_relaxed);
+			fDescriptor->set_parameter_value(fHandle, index, value);
 		}
 	}
 }
@@ -532,18 +568,23 @@ void CarlaInstrument::play(sampleFrame* workingBuffer)
     std::memset(buf1, 0, sizeof(float)*bufsize);
     std::memset(buf2, 0, sizeof(float)*bufsize);
 
+    sendParamChanges();
+
+    // collect the MIDI events queued since the last period
+    while (fMidiEventCount < kMaxMidiEvents && m_midiEventReader.read_space() > 0)
     {
-        const QMutexLocker ml(&fMutex);
+        fMidiEvents[fMidiEventCount++] = m_midiEventReader.read(1)[0];
+    }
+
 // TODO FIXME this is just here so it compiles.
 // https://github.com/falkTX/Carla/blob/8bceb9ed173a10b29038f8abb4383710c0e497c1/source/includes/CarlaNative.h
 //     FIXME for v3.0, use const for the input buffer
 #if CARLA_VERSION_HEX >= CARLA_VERSION_HEX_3
-        fDescriptor->process(fHandle, (const float**)rBuf, rBuf, bufsize, fMidiEvents, fMidiEventCount);
+    fDescriptor->process(fHandle, (const float**)rBuf, rBuf, bufsize, fMidiEvents, fMidiEventCount);
 #else
-        fDescriptor->process(fHandle, rBuf, rBuf, bufsize, fMidiEvents, fMidiEventCount);
+    fDescriptor->process(fHandle, rBuf, rBuf, bufsize, fMidiEvents, fMidiEventCount);
 #endif
-        fMidiEventCount = 0;
-    }
+    fMidiEventCount = 0;
 
     for (uint i=0; i < bufsize; ++i)
     {
@@ -554,21 +595,25 @@ void CarlaInstrument::play(sampleFrame* workingBuffer)
 
 bool CarlaInstrument::handleMidiEvent(const MidiEvent& event, const TimePos&, f_cnt_t offset)
 {
-    const QMutexLocker ml(&fMutex);
-
-    if (fMidiEventCount >= kMaxMidiEvents)
-        return false;
-
-    NativeMidiEvent& nEvent(fMidiEvents[fMidiEventCount++]);
+    NativeMidiEvent nEvent;
     std::memset(&nEvent, 0, sizeof(NativeMidiEvent));
 
     nEvent.port    = 0;
     nEvent.time    = offset;
     std::size_t written = writeToByteSeq(event, nEvent.data, sizeof(NativeMidiEvent::data));
-    if(written) { nEvent.size = written; }
-    else { --fMidiEventCount; }
+    if (!written) { return true; }
+    nEvent.size = written;
+
+    // this can be called by multiple threads (RT and non-RT) at the same time,
+    // and only for a few instructions, so spin instead of blocking
+    while (m_midiQueueLock.test_and_set(std::memory_order_acquire))
+        ; // spin
+
+    const bool queued = m_midiEventQueue.write(&nEvent, 1) == 1;
+
+    m_midiQueueLock.clear(std::memory_order_release);
 
-    return true;
+    return queued;
 }
 
 gui::PluginView* CarlaInstrument::instantiateView(QWidget* parent)
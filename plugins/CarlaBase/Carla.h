@@ -29,10 +29,13 @@
 #define CARLA_MIN_PARAM_VERSION 0x020090
 #define CARLA_VERSION_HEX_3 0x30000
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 // qt
 #include <QCloseEvent>
 #include <QDomElement>
-#include <QMutex>
 #include <QRegularExpression>
 
 // carla/source/includes
@@ -55,6 +58,7 @@
 #include "AutomatableModel.h"
 #include "Instrument.h"
 #include "InstrumentView.h"
+#include "LocklessRingBuffer.h"
 #include "SubWindow.h"
 
 class QPushButton;
@@ -206,6 +210,7 @@ private slots:
     void refreshParams(bool init = false);
     void clearParamModels();
     void paramModelChanged(uint32_t index);
+    void updateParamUi(uint32_t index);
     void updateParamModel(uint32_t index);
 
 private:
@@ -219,8 +224,20 @@ private:
     NativeMidiEvent fMidiEvents[kMaxMidiEvents];
     NativeTimeInfo  fTimeInfo;
 
-    // this is only needed because note-offs are being sent during play
-    QMutex fMutex;
+    // MIDI events from any thread (MIDI input, GUI, note-offs during play),
+    // handed to Carla at the start of the next play()
+    LocklessRingBuffer<NativeMidiEvent> m_midiEventQueue;
+    LocklessRingBufferReader<NativeMidiEvent> m_midiEventReader;
+    // the ringbuffer allows only one writer at a time
+    std::atomic_flag m_midiQueueLock = ATOMIC_FLAG_INIT;
+
+    // latest parameter values changed in LMMS (GUI or automation), handed to
+    // Carla at the start of the next play()
+    std::vector<std::atomic<float>> m_paramValues;
+    std::unique_ptr<std::atomic<bool>[]> m_paramDirty;
+    std::atomic<bool> m_anyParamDirty;
+
+    void sendParamChanges();
 
     uint8_t m_paramGroupCount;
     QList<CarlaParamFloatModel*> m_paramModels;
@@ -26,6 +26,8 @@
 #include "CompressorControlDialog.h"
 #include "CompressorControls.h"
 
+#include <algorithm>
+
 #include <QLabel>
 #include <QPainter>
 #include <QWheelEvent>
@@ -369,7 +371,9 @@ void CompressorControlDialog::updateDisplay()
 	int elapsedMil = m_timeElapsed.elapsed();
 	m_timeElapsed.restart();
 	m_timeSinceLastUpdate += elapsedMil;
-	m_compPixelMovement = int(m_timeSinceLastUpdate / COMP_MILLI_PER_PIXEL);
+	// after a long pause (e.g. while minimized), scrolling by more than the
+	// window width would only draw outside of it
+	m_compPixelMovement = std::min(int(m_timeSinceLastUpdate / COMP_MILLI_PER_PIXEL), m_windowSizeX);
 	m_timeSinceLastUpdate %= COMP_MILLI_PER_PIXEL;
 
 	// Time Change / Daylight Savings Time protection
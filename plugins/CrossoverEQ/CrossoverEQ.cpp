@@ -56,6 +56,10 @@ CrossoverEQEffect::CrossoverEQEffect( Model* parent, const Descriptor::SubPlugin
 	Effect( &crossovereq_plugin_descriptor, parent, key ),
 	m_controls( this ),
 	m_sampleRate( Engine::audioEngine()->outputSampleRate() ),
+	m_gain1Span( Engine::audioEngine()->framesPerPeriod(), dbfsToAmp( m_controls.m_gain1.value() ) ),
+	m_gain2Span( Engine::audioEngine()->framesPerPeriod(), dbfsToAmp( m_controls.m_gain2.value() ) ),
+	m_gain3Span( Engine::audioEngine()->framesPerPeriod(), dbfsToAmp( m_controls.m_gain3.value() ) ),
+	m_gain4Span( Engine::audioEngine()->framesPerPeriod(), dbfsToAmp( m_controls.m_gain4.value() ) ),
 	m_lp1( m_sampleRate ),
 	m_lp2( m_sampleRate ),
 	m_lp3( m_sampleRate ),
@@ -131,6 +135,11 @@ bool CrossoverEQEffect::processAudioBuffer( sampleFrame* buf, const fpp_t frames
 		m_gain4 = dbfsToAmp( m_controls.m_gain4.value() );
 	}
 	
+	const auto& gain1 = m_gain1Span.update( m_gain1, frames );
+	const auto& gain2 = m_gain2Span.update( m_gain2, frames );
+	const auto& gain3 = m_gain3Span.update( m_gain3, frames );
+	const auto& gain4 = m_gain4Span.update( m_gain4, frames );
+	
 	// mute values update
 	const bool mute1 = m_controls.m_mute1.value();
 	const bool mute2 = m_controls.m_mute2.value();
@@ -155,8 +164,8 @@ bool CrossoverEQEffect::processAudioBuffer( sampleFrame* buf, const fpp_t frames
 	{
 		for( int f = 0; f < frames; ++f )
 		{
-			m_work[f][0] += m_lp1.update( m_tmp1[f][0], 0 ) * m_gain1;
-			m_work[f][1] += m_lp1.update( m_tmp1[f][1], 1 ) * m_gain1;
+			m_work[f][0] += m_lp1.update( m_tmp1[f][0], 0 ) * gain1[f];
+			m_work[f][1] += m_lp1.update( m_tmp1[f][1], 1 ) * gain1[f];
 		}
 	}
 	
@@ -165,8 +174,8 @@ bool CrossoverEQEffect::processAudioBuffer( sampleFrame* buf, const fpp_t frames
 	{
 		for( int f = 0; f < frames; ++f )
 		{
-			m_work[f][0] += m_hp2.update( m_tmp1[f][0], 0 ) * m_gain2;
-			m_work[f][1] += m_hp2.update( m_tmp1[f][1], 1 ) * m_gain2;
+			m_work[f][0] += m_hp2.update( m_tmp1[f][0], 0 ) * gain2[f];
+			m_work[f][1] += m_hp2.update( m_tmp1[f][1], 1 ) * gain2[f];
 		}
 	}
 	
@@ -175,8 +184,8 @@ bool CrossoverEQEffect::processAudioBuffer( sampleFrame* buf, const fpp_t frames
 	{
 		for( int f = 0; f < frames; ++f )
 		{
-			m_work[f][0] += m_lp3.update( m_tmp2[f][0], 0 ) * m_gain3;
-			m_work[f][1] += m_lp3.update( m_tmp2[f][1], 1 ) * m_gain3;
+			m_work[f][0] += m_lp3.update( m_tmp2[f][0], 0 ) * gain3[f];
+			m_work[f][1] += m_lp3.update( m_tmp2[f][1], 1 ) * gain3[f];
 		}
 	}
 	
@@ -185,8 +194,8 @@ bool CrossoverEQEffect::processAudioBuffer( sampleFrame* buf, const fpp_t frames
 	{
 		for( int f = 0; f < frames; ++f )
 		{
-			m_work[f][0] += m_hp4.update( m_tmp2[f][0], 0 ) * m_gain4;
-			m_work[f][1] += m_hp4.update( m_tmp2[f][1], 1 ) * m_gain4;
+			m_work[f][0] += m_hp4.update( m_tmp2[f][0], 0 ) * gain4[f];
+			m_work[f][1] += m_hp4.update( m_tmp2[f][1], 1 ) * gain4[f];
 		}
 	}
 	
@@ -30,6 +30,7 @@
 #include "Effect.h"
 #include "CrossoverEQControls.h"
 #include "BasicFilters.h"
+#include "ValueSpan.h"
 
 namespace lmms
 {
@@ -60,6 +61,12 @@ private:
 	float m_gain2;
 	float m_gain3;
 	float m_gain4;
+
+	// band gains are ramped across a period when they change
+	SmoothedValueSpan m_gain1Span;
+	SmoothedValueSpan m_gain2Span;
+	SmoothedValueSpan m_gain3Span;
+	SmoothedValueSpan m_gain4Span;
 	
 	StereoLinkwitzRiley m_lp1;
 	StereoLinkwitzRiley m_lp2;
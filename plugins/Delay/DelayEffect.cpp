@@ -29,6 +29,7 @@
 #include "lmms_math.h"
 #include "plugin_export.h"
 #include "StereoDelay.h"
+#include "ValueSpan.h"
 
 namespace lmms
 {
@@ -94,22 +95,10 @@ bool DelayEffect::processAudioBuffer( sampleFrame* buf, const fpp_t frames )
 	auto dryS = std::array<sample_t, 2>{};
 	float lPeak = 0.0;
 	float rPeak = 0.0;
-	float length = m_delayControls.m_delayTimeModel.value();
-	float amplitude = m_delayControls.m_lfoAmountModel.value() * sr;
-	float lfoTime = 1.0 / m_delayControls.m_lfoTimeModel.value();
-	float feedback =  m_delayControls.m_feedbackModel.value();
-	ValueBuffer *lengthBuffer = m_delayControls.m_delayTimeModel.valueBuffer();
-	ValueBuffer *feedbackBuffer = m_delayControls.m_feedbackModel.valueBuffer();
-	ValueBuffer *lfoTimeBuffer = m_delayControls.m_lfoTimeModel.valueBuffer();
-	ValueBuffer *lfoAmountBuffer = m_delayControls.m_lfoAmountModel.valueBuffer();
-	int lengthInc = lengthBuffer ? 1 : 0;
-	int amplitudeInc = lfoAmountBuffer ? 1 : 0;
-	int lfoTimeInc = lfoTimeBuffer ? 1 : 0;
-	int feedbackInc = feedbackBuffer ? 1 : 0;
-	float *lengthPtr = lengthBuffer ? &( lengthBuffer->values()[ 0 ] ) : &length;
-	float *amplitudePtr = lfoAmountBuffer ? &( lfoAmountBuffer->values()[ 0 ] ) : &amplitude;
-	float *lfoTimePtr = lfoTimeBuffer ? &( lfoTimeBuffer->values()[ 0 ] ) : &lfoTime;
-	float *feedbackPtr = feedbackBuffer ? &( feedbackBuffer->values()[ 0 ] ) : &feedback;
+	const auto length = ValueSpan{ m_delayControls.m_delayTimeModel };
+	const auto amplitude = ValueSpan{ m_delayControls.m_lfoAmountModel };
+	const auto lfoTime = ValueSpan{ m_delayControls.m_lfoTimeModel };
+	const auto feedback = ValueSpan{ m_delayControls.m_feedbackModel };
 
 	if( m_delayControls.m_outGainModel.isValueChanged() )
 	{
@@ -121,10 +110,10 @@ bool DelayEffect::processAudioBuffer( sampleFrame* buf, const fpp_t frames )
 		dryS[0] = buf[f][0];
 		dryS[1] = buf[f][1];
 
-		m_delay->setFeedback( *feedbackPtr );
-		m_lfo->setFrequency( *lfoTimePtr );
-		m_currentLength = static_cast<int>(*lengthPtr * Engine::audioEngine()->outputSampleRate());
-		m_delay->setLength( m_currentLength + ( *amplitudePtr * ( float )m_lfo->tick() ) );
+		m_delay->setFeedback( feedback[f] );
+		m_lfo->setFrequency( 1.0 / lfoTime[f] );
+		m_currentLength = static_cast<int>( length[f] * sr );
+		m_delay->setLength( m_currentLength + ( amplitude[f] * sr * ( float )m_lfo->tick() ) );
 		m_delay->tick( buf[f] );
 
 		buf[f][0] *= m_outGain;
@@ -136,11 +125,6 @@ bool DelayEffect::processAudioBuffer( sampleFrame* buf, const fpp_t frames )
 		buf[f][0] = ( d * dryS[0] ) + ( w * buf[f][0] );
 		buf[f][1] = ( d * dryS[1] ) + ( w * buf[f][1] );
 		outSum += buf[f][0]*buf[f][0] + buf[f][1]*buf[f][1];
-
-		lengthPtr += lengthInc;
-		amplitudePtr += amplitudeInc;
-		lfoTimePtr += lfoTimeInc;
-		feedbackPtr += feedbackInc;
 	}
 	checkGate( outSum / frames );
 	m_delayControls.m_outPeakL = lPeak;
@@ -24,6 +24,8 @@
 
 #include "Dispersion.h"
 
+#include <algorithm>
+
 #include "embed.h"
 #include "plugin_export.h"
 
@@ -55,6 +57,8 @@ DispersionEffect::DispersionEffect(Model* parent, const Descriptor::SubPluginFea
 	m_sampleRate(Engine::audioEngine()->outputSampleRate()),
 	m_amountVal(0)
 {
+	calcCoefficients(m_dispersionControls.m_freqModel.value(), m_dispersionControls.m_resoModel.value(),
+		m_apCoeff1, m_apCoeff2);
 }
 
 
@@ -70,16 +74,26 @@ bool DispersionEffect::processAudioBuffer(sampleFrame* buf, const fpp_t frames)
 	const float w = wetLevel();
 	
 	const int amount = m_dispersionControls.m_amountModel.value();
-	const float freq = m_dispersionControls.m_freqModel.value();
-	const float reso = m_dispersionControls.m_resoModel.value();
 	float feedback = m_dispersionControls.m_feedbackModel.value();
 	const bool dc = m_dispersionControls.m_dcModel.value();
-	
-	// All-pass coefficient calculation
-	const float w0 = (F_2PI / m_sampleRate) * freq;
-	const float a0 = 1 + (std::sin(w0) / (reso * 2.f));
-	float apCoeff1 = (1 - (a0 - 1)) / a0;
-	float apCoeff2 = (-2 * std::cos(w0)) / a0;
+
+	// When frequency or resonance are automated, only the coefficients at the end of the
+	// period are computed, and the filters ramp towards them linearly over the period
+	const ValueBuffer* freqBuf = m_dispersionControls.m_freqModel.valueBuffer();
+	const ValueBuffer* resoBuf = m_dispersionControls.m_resoModel.valueBuffer();
+	const float freq = freqBuf ? freqBuf->value(frames - 1) : m_dispersionControls.m_freqModel.value();
+	const float reso = resoBuf ? resoBuf->value(frames - 1) : m_dispersionControls.m_resoModel.value();
+
+	float apCoeff1Target;
+	float apCoeff2Target;
+	calcCoefficients(freq, reso, apCoeff1Target, apCoeff2Target);
+
+	float apCoeff1 = m_apCoeff1;
+	float apCoeff2 = m_apCoeff2;
+	const float apCoeff1Inc = (apCoeff1Target - apCoeff1) / frames;
+	const float apCoeff2Inc = (apCoeff2Target - apCoeff2) / frames;
+	m_apCoeff1 = apCoeff1Target;
+	m_apCoeff2 = apCoeff2Target;
 	
 	float dcCoeff = 0.001 * (44100.f / m_sampleRate);
 	
@@ -88,10 +102,7 @@ bool DispersionEffect::processAudioBuffer(sampleFrame* buf, const fpp_t frames)
 		if (amount < m_amountVal)
 		{
 			// Flush filter buffers when they're no longer in use
-			for (int i = amount * 2; i < m_amountVal * 2; ++i)
-			{
-				m_state.x0[i] = m_state.x1[i] = m_state.y0[i] = m_state.y1[i] = 0;
-			}
+			std::fill(m_state.begin() + amount, m_state.begin() + m_amountVal, StereoAllpass{});
 		}
 		m_amountVal = amount;
 	}
@@ -105,7 +116,9 @@ bool DispersionEffect::processAudioBuffer(sampleFrame* buf, const fpp_t frames)
 	for (fpp_t f = 0; f < frames; ++f)
 	{
 		std::array<sample_t, 2> s = { buf[f][0] + m_feedbackVal[0], buf[f][1] + m_feedbackVal[1] };
-		
+
+		apCoeff1 += apCoeff1Inc;
+		apCoeff2 += apCoeff2Inc;
 		runDispersionAP(m_amountVal, apCoeff1, apCoeff2, s);
 		m_feedbackVal[0] = s[0] * feedback;
 		m_feedbackVal[1] = s[1] * feedback;
@@ -132,19 +145,33 @@ bool DispersionEffect::processAudioBuffer(sampleFrame* buf, const fpp_t frames)
 
 void DispersionEffect::runDispersionAP(const int filtNum, const float apCoeff1, const float apCoeff2, std::array<sample_t, 2> &put)
 {
-	for (int i = 0; i < filtNum * 2; ++i)
+	// Both channels are processed side by side, which lets the compiler keep each stage in one SIMD register
+	alignas(16) std::array<sample_t, 2> in = put;
+	for (int i = 0; i < filtNum; ++i)
 	{
-		const int channel = i % 2;
-		const sample_t currentInput = put[channel];
-		const sample_t filterOutput = apCoeff1 * (currentInput - m_state.y1[i])
-			+ apCoeff2 * (m_state.x0[i] - m_state.y0[i]) + m_state.x1[i];
-		m_state.x1[i] = m_state.x0[i];
-		m_state.x0[i] = currentInput;
-		m_state.y1[i] = m_state.y0[i];
-		m_state.y0[i] = filterOutput;
-
-		put[channel] = filterOutput;
+		StereoAllpass& ap = m_state[i];
+		alignas(16) std::array<sample_t, 2> out;
+		for (int ch = 0; ch < 2; ++ch)
+		{
+			out[ch] = apCoeff1 * (in[ch] - ap.y1[ch]) + apCoeff2 * (ap.x0[ch] - ap.y0[ch]) + ap.x1[ch];
+			ap.x1[ch] = ap.x0[ch];
+			ap.x0[ch] = in[ch];
+			ap.y1[ch] = ap.y0[ch];
+			ap.y0[ch] = out[ch];
+		}
+		in = out;
 	}
+	put = in;
+}
+
+
+void DispersionEffect::calcCoefficients(const float freq, const float reso, float& apCoeff1, float& apCoeff2) const
+{
+	// All-pass coefficient calculation
+	const float w0 = (F_2PI / m_sampleRate) * freq;
+	const float a0 = 1 + (std::sin(w0) / (reso * 2.f));
+	apCoeff1 = (1 - (a0 - 1)) / a0;
+	apCoeff2 = (-2 * std::cos(w0)) / a0;
 }
 
 
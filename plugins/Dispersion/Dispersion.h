@@ -26,6 +26,8 @@
 #ifndef LMMS_DISPERSION_H
 #define LMMS_DISPERSION_H
 
+#include <array>
+
 #include "DispersionControls.h"
 #include "Effect.h"
 
@@ -51,20 +53,28 @@ public:
 	void runDispersionAP(const int filtNum, const float apCoeff1, const float apCoeff2, std::array<sample_t, 2> &put);
 
 private:
+	void calcCoefficients(const float freq, const float reso, float& apCoeff1, float& apCoeff2) const;
+
 	DispersionControls m_dispersionControls;
 	
 	float m_sampleRate;
 	
 	int m_amountVal;
 	
-	using Filter = std::array<sample_t, MAX_DISPERSION_FILTERS * 2>;
-	struct FilterState {
-		Filter x0{};
-		Filter x1{};
-		Filter y0{};
-		Filter y1{};
+	// Both channels of a stage are stored next to each other so the
+	// cascade can process them together in SIMD lanes
+	struct StereoAllpass
+	{
+		alignas(16) std::array<sample_t, 2> x0{};
+		std::array<sample_t, 2> x1{};
+		std::array<sample_t, 2> y0{};
+		std::array<sample_t, 2> y1{};
 	};
-	FilterState m_state = {};
+	std::array<StereoAllpass, MAX_DISPERSION_FILTERS> m_state = {};
+
+	// Coefficients used at the end of the previous period, for interpolation
+	float m_apCoeff1;
+	float m_apCoeff2;
 	
 	std::array<float, 2> m_feedbackVal{};
 	std::array<float, 2> m_integrator{};
@@ -55,7 +55,10 @@ Plugin::Descriptor PLUGIN_EXPORT dualfilter_plugin_descriptor =
 
 DualFilterEffect::DualFilterEffect( Model* parent, const Descriptor::SubPluginFeatures::Key* key ) :
 	Effect( &dualfilter_plugin_descriptor, parent, key ),
-	m_dfControls( this )
+	m_dfControls( this ),
+	m_gain1Span( Engine::audioEngine()->framesPerPeriod(), m_dfControls.m_gain1Model.value() ),
+	m_gain2Span( Engine::audioEngine()->framesPerPeriod(), m_dfControls.m_gain2Model.value() ),
+	m_mixSpan( Engine::audioEngine()->framesPerPeriod(), m_dfControls.m_mixModel.value() )
 {
 	m_filter1 = new BasicFilters<2>( Engine::audioEngine()->outputSampleRate() );
 	m_filter2 = new BasicFilters<2>( Engine::audioEngine()->outputSampleRate() );
@@ -99,37 +102,13 @@ bool DualFilterEffect::processAudioBuffer( sampleFrame* buf, const fpp_t frames
 		m_filter2changed = true;
 	}
 
-	float cut1 = m_dfControls.m_cut1Model.value();
-	float res1 = m_dfControls.m_res1Model.value();
-	float gain1 = m_dfControls.m_gain1Model.value();
-	float cut2 = m_dfControls.m_cut2Model.value();
-	float res2 = m_dfControls.m_res2Model.value();
-	float gain2 = m_dfControls.m_gain2Model.value();
-	float mix = m_dfControls.m_mixModel.value();
-
-	ValueBuffer *cut1Buffer = m_dfControls.m_cut1Model.valueBuffer();
-	ValueBuffer *res1Buffer = m_dfControls.m_res1Model.valueBuffer();
-	ValueBuffer *gain1Buffer = m_dfControls.m_gain1Model.valueBuffer();
-	ValueBuffer *cut2Buffer = m_dfControls.m_cut2Model.valueBuffer();
-	ValueBuffer *res2Buffer = m_dfControls.m_res2Model.valueBuffer();
-	ValueBuffer *gain2Buffer = m_dfControls.m_gain2Model.valueBuffer();
-	ValueBuffer *mixBuffer = m_dfControls.m_mixModel.valueBuffer();
-
-	int cut1Inc = cut1Buffer ? 1 : 0;
-	int res1Inc = res1Buffer ? 1 : 0;
-	int gain1Inc = gain1Buffer ? 1 : 0;
-	int cut2Inc = cut2Buffer ? 1 : 0;
-	int res2Inc = res2Buffer ? 1 : 0;
-	int gain2Inc = gain2Buffer ? 1 : 0;
-	int mixInc = mixBuffer ? 1 : 0;
-
-	float *cut1Ptr = cut1Buffer ? &( cut1Buffer->values()[ 0 ] ) : &cut1;
-	float *res1Ptr = res1Buffer ? &( res1Buffer->values()[ 0 ] ) : &res1;
-	float *gain1Ptr = gain1Buffer ? &( gain1Buffer->values()[ 0 ] ) : &gain1;
-	float *cut2Ptr = cut2Buffer ? &( cut2Buffer->values()[ 0 ] ) : &cut2;
-	float *res2Ptr = res2Buffer ? &( res2Buffer->values()[ 0 ] ) : &res2;
-	float *gain2Ptr = gain2Buffer ? &( gain2Buffer->values()[ 0 ] ) : &gain2;
-	float *mixPtr = mixBuffer ? &( mixBuffer->values()[ 0 ] ) : &mix;
+	const auto cut1 = ValueSpan{ m_dfControls.m_cut1Model };
+	const auto res1 = ValueSpan{ m_dfControls.m_res1Model };
+	const auto& gain1 = m_gain1Span.update( m_dfControls.m_gain1Model, frames );
+	const auto cut2 = ValueSpan{ m_dfControls.m_cut2Model };
+	const auto res2 = ValueSpan{ m_dfControls.m_res2Model };
+	const auto& gain2 = m_gain2Span.update( m_dfControls.m_gain2Model, frames );
+	const auto& mix = m_mixSpan.update( m_dfControls.m_mixModel, frames );
 
 	const bool enabled1 = m_dfControls.m_enabled1Model.value();
 	const bool enabled2 = m_dfControls.m_enabled2Model.value();
@@ -141,10 +120,10 @@ bool DualFilterEffect::processAudioBuffer( sampleFrame* buf, const fpp_t frames
 	for( fpp_t f = 0; f < frames; ++f )
 	{
 		// get mix amounts for wet signals of both filters
-		const float mix2 = ( ( *mixPtr + 1.0f ) * 0.5f );
+		const float mix2 = ( ( mix[f] + 1.0f ) * 0.5f );
 		const float mix1 = 1.0f - mix2;
-		const float gain1 = *gain1Ptr * 0.01f;
-		const float gain2 = *gain2Ptr * 0.01f;
+		const float g1 = gain1[f] * 0.01f;
+		const float g2 = gain2[f] * 0.01f;
 		auto s = std::array{0.0f, 0.0f};	// mix
 		auto s1 = std::array{buf[f][0], buf[f][1]};	// filter 1
 		auto s2 = std::array{buf[f][0], buf[f][1]};	// filter 2
@@ -154,20 +133,20 @@ bool DualFilterEffect::processAudioBuffer( sampleFrame* buf, const fpp_t frames
 		{
 			//update filter 1 params here
 			// recalculate only when necessary: either cut/res is changed, or the changed-flag is set (filter type or samplerate changed)
-			if( ( ( *cut1Ptr != m_currentCut1 ||
-				*res1Ptr != m_currentRes1 ) ) || m_filter1changed )
+			if( ( ( cut1[f] != m_currentCut1 ||
+				res1[f] != m_currentRes1 ) ) || m_filter1changed )
 			{
-				m_filter1->calcFilterCoeffs( *cut1Ptr, *res1Ptr );
+				m_filter1->calcFilterCoeffs( cut1[f], res1[f] );
 				m_filter1changed = false;
-				m_currentCut1 = *cut1Ptr;
-				m_currentRes1 = *res1Ptr;
+				m_currentCut1 = cut1[f];
+				m_currentRes1 = res1[f];
 			}
 			s1[0] = m_filter1->update( s1[0], 0 );
 			s1[1] = m_filter1->update( s1[1], 1 );
 
 			// apply gain
-			s1[0] *= gain1;
-			s1[1] *= gain1;
+			s1[0] *= g1;
+			s1[1] *= g1;
 
 			// apply mix
 			s[0] += ( s1[0] * mix1 );
@@ -178,20 +157,20 @@ bool DualFilterEffect::processAudioBuffer( sampleFrame* buf, const fpp_t frames
 		if( enabled2 )
 		{
 			//update filter 2 params here
-			if( ( ( *cut2Ptr != m_currentCut2 ||
-								*res2Ptr != m_currentRes2 ) ) || m_filter2changed )
+			if( ( ( cut2[f] != m_currentCut2 ||
+								res2[f] != m_currentRes2 ) ) || m_filter2changed )
 			{
-				m_filter2->calcFilterCoeffs( *cut2Ptr, *res2Ptr );
+				m_filter2->calcFilterCoeffs( cut2[f], res2[f] );
 				m_filter2changed = false;
-				m_currentCut2 = *cut2Ptr;
-				m_currentRes2 = *res2Ptr;
+				m_currentCut2 = cut2[f];
+				m_currentRes2 = res2[f];
 			}
 			s2[0] = m_filter2->update( s2[0], 0 );
 			s2[1] = m_filter2->update( s2[1], 1 );
 
 			//apply gain
-			s2[0] *= gain2;
-			s2[1] *= gain2;
+			s2[0] *= g2;
+			s2[1] *= g2;
 
 			// apply mix
 			s[0] += ( s2[0] * mix2 );
@@ -202,15 +181,6 @@ bool DualFilterEffect::processAudioBuffer( sampleFrame* buf, const fpp_t frames
 		buf[f][0] = d * buf[f][0] + w * s[0];
 		buf[f][1] = d * buf[f][1] + w * s[1];
 		outSum += buf[f][0] * buf[f][0] + buf[f][1] * buf[f][1];
-
-		//increment pointers
-		cut1Ptr += cut1Inc;
-		res1Ptr += res1Inc;
-		gain1Ptr += gain1Inc;
-		cut2Ptr += cut2Inc;
-		res2Ptr += res2Inc;
-		gain2Ptr += gain2Inc;
-		mixPtr += mixInc;
 	}
 
 	checkGate( outSum / frames );
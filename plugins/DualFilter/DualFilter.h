@@ -30,6 +30,7 @@
 #include "Effect.h"
 #include "DualFilterControls.h"
 #include "BasicFilters.h"
+#include "ValueSpan.h"
 
 namespace lmms
 {
@@ -64,6 +65,11 @@ private:
 	float m_currentCut2;
 	float m_currentRes2;
 
+	// gains and mix are smoothed to avoid zipper noise on knob changes
+	SmoothedValueSpan m_gain1Span;
+	SmoothedValueSpan m_gain2Span;
+	SmoothedValueSpan m_mixSpan;
+
 	friend class DualFilterControls;
 
 } ;
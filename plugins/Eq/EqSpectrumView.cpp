@@ -297,9 +297,12 @@ float EqSpectrumView::bandToFreq( int index )
 
 void EqSpectrumView::periodicalUpdate()
 {
-	m_periodicalUpdate = true;
 	m_analyser->setActive( isVisible() );
-	update();
+	if( isVisible() )
+	{
+		m_periodicalUpdate = true;
+		update();
+	}
 }
 
 
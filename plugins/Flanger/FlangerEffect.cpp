@@ -27,6 +27,7 @@
 #include "MonoDelay.h"
 #include "Noise.h"
 #include "QuadratureLfo.h"
+#include "ValueSpan.h"
 
 #include "embed.h"
 #include "plugin_export.h"
@@ -99,27 +100,29 @@ bool FlangerEffect::processAudioBuffer( sampleFrame *buf, const fpp_t frames )
 	double outSum = 0.0;
 	const float d = dryLevel();
 	const float w = wetLevel();
-	const float length = m_flangerControls.m_delayTimeModel.value() * Engine::audioEngine()->outputSampleRate();
-	const float noise = m_flangerControls.m_whiteNoiseAmountModel.value();
-	float amplitude = m_flangerControls.m_lfoAmountModel.value() * Engine::audioEngine()->outputSampleRate();
+	const float sr = Engine::audioEngine()->outputSampleRate();
+	const auto length = ValueSpan{ m_flangerControls.m_delayTimeModel };
+	const auto noise = ValueSpan{ m_flangerControls.m_whiteNoiseAmountModel };
+	const auto amplitude = ValueSpan{ m_flangerControls.m_lfoAmountModel };
+	const auto feedback = ValueSpan{ m_flangerControls.m_feedbackModel };
 	bool invertFeedback = m_flangerControls.m_invertFeedbackModel.value();
 	m_lfo->setFrequency(  1.0/m_flangerControls.m_lfoFrequencyModel.value() );
 	m_lfo->setOffset( m_flangerControls.m_lfoPhaseModel.value() / 180 * D_PI );
-	m_lDelay->setFeedback( m_flangerControls.m_feedbackModel.value() );
-	m_rDelay->setFeedback( m_flangerControls.m_feedbackModel.value() );
 	auto dryS = std::array<sample_t, 2>{};
 	for( fpp_t f = 0; f < frames; ++f )
 	{
 		float leftLfo;
 		float rightLfo;
 
-		buf[f][0] += m_noise->tick() * noise;
-		buf[f][1] += m_noise->tick() * noise;
+		buf[f][0] += m_noise->tick() * noise[f];
+		buf[f][1] += m_noise->tick() * noise[f];
 		dryS[0] = buf[f][0];
 		dryS[1] = buf[f][1];
 		m_lfo->tick(&leftLfo, &rightLfo);
-		m_lDelay->setLength( ( float )length + amplitude * (leftLfo+1.0)  );
-		m_rDelay->setLength( ( float )length + amplitude * (rightLfo+1.0)  );
+		m_lDelay->setFeedback( feedback[f] );
+		m_rDelay->setFeedback( feedback[f] );
+		m_lDelay->setLength( length[f] * sr + amplitude[f] * sr * (leftLfo+1.0)  );
+		m_rDelay->setLength( length[f] * sr + amplitude[f] * sr * (rightLfo+1.0)  );
 		if(invertFeedback)
 		{
 			m_lDelay->tick( &buf[f][1] );
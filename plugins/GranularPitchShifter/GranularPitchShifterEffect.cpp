@@ -24,6 +24,7 @@
 
 #include "GranularPitchShifterEffect.h"
 
+#include <algorithm>
 #include <cmath>
 #include "embed.h"
 #include "plugin_export.h"
@@ -52,7 +53,9 @@ Plugin::Descriptor PLUGIN_EXPORT granularpitchshifter_plugin_descriptor =
 GranularPitchShifterEffect::GranularPitchShifterEffect(Model* parent, const Descriptor::SubPluginFeatures::Key* key) :
 	Effect(&granularpitchshifter_plugin_descriptor, parent, key),
 	m_granularpitchshifterControls(this),
-	m_prefilter({PrefilterLowpass(), PrefilterLowpass()})
+	m_prefilter({PrefilterLowpass(), PrefilterLowpass()}),
+	m_grainBuf(Engine::audioEngine()->framesPerPeriod()),
+	m_windowBuf(Engine::audioEngine()->framesPerPeriod())
 {
 	autoQuitModel()->setValue(autoQuitModel()->maxValue());
 	
@@ -90,16 +93,26 @@ bool GranularPitchShifterEffect::processAudioBuffer(sampleFrame* buf, const fpp_
 		m_glideCoef = glide > 0 ? std::exp(-1 / (glide * m_sampleRate)) : 0;
 	}
 	
-	const float shapeK = cosWindowApproxK(shape);
+	if (shape != m_windowShape || fadeLength != m_windowFadeLength)
+	{
+		updateWindowTable(shape, fadeLength);
+	}
+	
 	const int sizeSamples = m_sampleRate / size;
 	const float waitMult = sizeSamples / (density * 2);
+	const bool pitchAutomated = pitchBuf || pitchSpreadBuf;
 
-	for (fpp_t f = 0; f < frames; ++f)
+	// The period is processed in segments. Pitch updates and grain spawns only happen at the start of a segment,
+	// so in between every grain can be rendered in one go.
+	for (fpp_t f = 0; f < frames;)
 	{
 		const double pitch = (pitchBuf ? pitchBuf->value(f) : m_granularpitchshifterControls.m_pitchModel.value()) * (1. / 12.);
 		const double pitchSpread = (pitchSpreadBuf ? pitchSpreadBuf->value(f) : m_granularpitchshifterControls.m_pitchSpreadModel.value()) * (1. / 24.);
 		
-		// interpolate pitch depending on glide
+		// interpolate pitch depending on glide, catching up on the samples of the previous segment
+		const int glideSteps = m_glideStepsPending + 1;
+		const double glideCoef = glideSteps == 1 ? m_glideCoef : std::pow(m_glideCoef, glideSteps);
+		bool gliding = false;
 		for (int i = 0; i < 2; ++i)
 		{
 			double targetVal = pitch + pitchSpread * (i ? 1. : -1.);
@@ -107,9 +120,10 @@ bool GranularPitchShifterEffect::processAudioBuffer(sampleFrame* buf, const fpp_
 			if (targetVal == m_truePitch[i]) { continue; }
 			m_updatePitches = true;
 			
-			m_truePitch[i] = m_glideCoef * m_truePitch[i] + (1. - m_glideCoef) * targetVal;
+			m_truePitch[i] = glideCoef * m_truePitch[i] + (1. - glideCoef) * targetVal;
 			// we crudely lock the pitch to the target value once it gets close enough, so we can save on CPU
 			if (std::abs(targetVal - m_truePitch[i]) < GlideSnagRadius) { m_truePitch[i] = targetVal; }
+			else { gliding = true; }
 		}
 		
 		// this stuff is computationally expensive, so we should only do it when necessary
@@ -150,9 +164,6 @@ bool GranularPitchShifterEffect::processAudioBuffer(sampleFrame* buf, const fpp_
 			m_prefilter[1].setCoefs(m_sampleRate, std::min(m_nyquist / static_cast<float>(speed[1]), m_nyquist) * PrefilterBandwidth);
 		}
 		
-		std::array<float, 2> s = {0, 0};
-		std::array<float, 2> filtered = {buf[f][0], buf[f][1]};
-		
 		// spawn a new grain if it's time
 		if (++m_timeSinceLastGrain >= m_nextWaitRandomization * waitMult)
 		{
@@ -183,60 +194,56 @@ bool GranularPitchShifterEffect::processAudioBuffer(sampleFrame* buf, const fpp_
 			++m_grainCount;
 		}
 		
-		for (int i = 0; i < m_grainCount; ++i)
+		// the segment ends right before the next grain spawn or pitch update
+		int length = frames - f;
+		const double untilSpawn = std::ceil(m_nextWaitRandomization * waitMult - m_timeSinceLastGrain);
+		length = std::min(length, static_cast<int>(std::clamp(untilSpawn, 1., static_cast<double>(length))));
+		if (gliding || pitchAutomated) { length = std::min(length, PitchUpdateInterval); }
+		length = safeSegmentLength(length);
+		
+		renderGrains(length);
+		
+		for (int k = 0; k < length; ++k)
 		{
-			m_grains[i].phase += std::max(m_grains[i].phaseSpeed[0], m_grains[i].phaseSpeed[1]);
-			if (m_grains[i].phase >= 1)
+			std::array<float, 2> s = m_grainBuf[k];
+			std::array<float, 2> filtered = {buf[f + k][0], buf[f + k][1]};
+			
+			// note that adding two signals together, when uncorrelated, results in a signal power multiplication of sqrt(2), not 2
+			s[0] *= densityInvRoot;
+			s[1] *= densityInvRoot;
+			
+			// 1-pole highpass for DC offset removal, to make feedback safer
+			s[0] -= (m_dcVal[0] = (1.f - m_dcCoeff) * s[0] + m_dcCoeff * m_dcVal[0]);
+			s[1] -= (m_dcVal[1] = (1.f - m_dcCoeff) * s[1] + m_dcCoeff * m_dcVal[1]);
+			
+			// cheap safety saturator to protect against infinite feedback
+			if (feedback > 0)
 			{
-				// grain is done, delete it
-				std::swap(m_grains[i], m_grains[m_grainCount-1]);
-				m_grains.pop_back();
-				--i;
-				--m_grainCount;
-				continue;
+				s[0] = safetySaturate(s[0]);
+				s[1] = safetySaturate(s[1]);
 			}
 			
-			m_grains[i].readPoint[0] += m_grains[i].grainSpeed[0];
-			m_grains[i].readPoint[1] += m_grains[i].grainSpeed[1];
-			if (m_grains[i].readPoint[0] >= m_ringBufLength) { m_grains[i].readPoint[0] -= m_ringBufLength; }
-			if (m_grains[i].readPoint[1] >= m_ringBufLength) { m_grains[i].readPoint[1] -= m_ringBufLength; }
+			if (++m_writePoint >= m_ringBufLength)
+			{
+				m_writePoint = 0;
+			}
+			if (prefilter)
+			{
+				filtered[0] = m_prefilter[0].process(filtered[0]);
+				filtered[1] = m_prefilter[1].process(filtered[1]);
+			}
 			
-			const float fadePos = std::clamp((-std::abs(-2.f * static_cast<float>(m_grains[i].phase) + 1.f) + 0.5f) * fadeLength + 0.5f, 0.f, 1.f);
-			const float windowVal = cosHalfWindowApprox(fadePos, shapeK);
-			s[0] += getHermiteSample(m_grains[i].readPoint[0], 0) * windowVal;
-			s[1] += getHermiteSample(m_grains[i].readPoint[1], 1) * windowVal;
-		}
-		
-		// note that adding two signals together, when uncorrelated, results in a signal power multiplication of sqrt(2), not 2
-		s[0] *= densityInvRoot;
-		s[1] *= densityInvRoot;
-		
-		// 1-pole highpass for DC offset removal, to make feedback safer
-		s[0] -= (m_dcVal[0] = (1.f - m_dcCoeff) * s[0] + m_dcCoeff * m_dcVal[0]);
-		s[1] -= (m_dcVal[1] = (1.f - m_dcCoeff) * s[1] + m_dcCoeff * m_dcVal[1]);
-		
-		// cheap safety saturator to protect against infinite feedback
-		if (feedback > 0)
-		{
-			s[0] = safetySaturate(s[0]);
-			s[1] = safetySaturate(s[1]);
-		}
-		
-		if (++m_writePoint >= m_ringBufLength)
-		{
-			m_writePoint = 0;
-		}
-		if (prefilter)
-		{
-			filtered[0] = m_prefilter[0].process(filtered[0]);
-			filtered[1] = m_prefilter[1].process(filtered[1]);
+			m_ringBuf[m_writePoint][0] = filtered[0] + s[0] * feedback;
+			m_ringBuf[m_writePoint][1] = filtered[1] + s[1] * feedback;
+			
+			buf[f + k][0] = d * buf[f + k][0] + w * s[0];
+			buf[f + k][1] = d * buf[f + k][1] + w * s[1];
 		}
 		
-		m_ringBuf[m_writePoint][0] = filtered[0] + s[0] * feedback;
-		m_ringBuf[m_writePoint][1] = filtered[1] + s[1] * feedback;
-			
-		buf[f][0] = d * buf[f][0] + w * s[0];
-		buf[f][1] = d * buf[f][1] + w * s[1];
+		m_timeSinceLastGrain += length - 1;
+		// only a glide in progress has to catch up, a settled pitch starts gliding from the next change
+		m_glideStepsPending = gliding ? length - 1 : 0;
+		f += length;
 	}
 	
 	if (m_sampleRateNeedsUpdate)
@@ -248,6 +255,104 @@ bool GranularPitchShifterEffect::processAudioBuffer(sampleFrame* buf, const fpp_
 	return isRunning();
 }
 
+void GranularPitchShifterEffect::updateWindowTable(float shape, float fadeLength)
+{
+	m_windowShape = shape;
+	m_windowFadeLength = fadeLength;
+	
+	const float shapeK = cosWindowApproxK(shape);
+	for (int i = 0; i <= WindowTableSize; ++i)
+	{
+		const float phase = static_cast<float>(i) / WindowTableSize;
+		const float fadePos = std::clamp((-std::abs(-2.f * phase + 1.f) + 0.5f) * fadeLength + 0.5f, 0.f, 1.f);
+		m_windowTable[i] = cosHalfWindowApprox(fadePos, shapeK);
+	}
+}
+
+
+int GranularPitchShifterEffect::safeSegmentLength(int maxLength) const
+{
+	// Grains are rendered ahead of the ring buffer writes of the current segment,
+	// so none of them may read a sample that is written during the segment.
+	// Reading one sample ahead is always safe, since that matches the per-sample order.
+	int length = maxLength;
+	for (int i = 0; i < m_grainCount && length > 1; ++i)
+	{
+		for (int j = 0; j < 2; ++j)
+		{
+			double distance = m_writePoint - m_grains[i].readPoint[j];
+			if (distance <= 0) { distance += m_ringBufLength; }
+			// the hermite interpolation reads up to two samples after the read point, and one before it
+			const double ahead = (distance - 3.) / m_grains[i].grainSpeed[j];
+			const double behind = m_ringBufLength - distance - 2.;
+			length = static_cast<int>(std::clamp(std::min({ahead, behind, static_cast<double>(length)}), 1., static_cast<double>(length)));
+		}
+	}
+	return length;
+}
+
+
+void GranularPitchShifterEffect::renderGrains(int length)
+{
+	std::fill(m_grainBuf.begin(), m_grainBuf.begin() + length, std::array<float, 2>{0, 0});
+	
+	for (int i = 0; i < m_grainCount; ++i)
+	{
+		Grain& grain = m_grains[i];
+		
+		// window values for this grain, up to the point where it ends
+		const double phaseSpeed = std::max(grain.phaseSpeed[0], grain.phaseSpeed[1]);
+		int active = 0;
+		for (; active < length; ++active)
+		{
+			grain.phase += phaseSpeed;
+			if (grain.phase >= 1) { break; }
+			m_windowBuf[active] = windowAt(grain.phase);
+		}
+		
+		for (int ch = 0; ch < 2; ++ch)
+		{
+			const double grainSpeed = grain.grainSpeed[ch];
+			double readPoint = grain.readPoint[ch];
+			int k = 0;
+			while (k < active)
+			{
+				// as long as neither interpolation neighbour wraps around the ring buffer, read directly
+				if (readPoint + grainSpeed >= 1.)
+				{
+					const int run = std::min(active, k + std::max(static_cast<int>((m_ringBufLength - 3 - readPoint) / grainSpeed), 0));
+					for (; k < run; ++k)
+					{
+						readPoint += grainSpeed;
+						const int index = static_cast<int>(readPoint);
+						const float fraction = static_cast<float>(readPoint - index);
+						m_grainBuf[k][ch] += hermiteInterpolate(m_ringBuf[index - 1][ch], m_ringBuf[index][ch],
+							m_ringBuf[index + 1][ch], m_ringBuf[index + 2][ch], fraction) * m_windowBuf[k];
+					}
+				}
+				if (k < active)
+				{
+					readPoint += grainSpeed;
+					if (readPoint >= m_ringBufLength) { readPoint -= m_ringBufLength; }
+					m_grainBuf[k][ch] += getHermiteSample(readPoint, ch) * m_windowBuf[k];
+					++k;
+				}
+			}
+			grain.readPoint[ch] = readPoint;
+		}
+		
+		if (active < length)
+		{
+			// grain is done, delete it
+			std::swap(m_grains[i], m_grains[m_grainCount - 1]);
+			m_grains.pop_back();
+			--i;
+			--m_grainCount;
+		}
+	}
+}
+
+
 void GranularPitchShifterEffect::changeSampleRate()
 {
 	const int range = m_granularpitchshifterControls.m_rangeModel.value();
@@ -41,6 +41,8 @@ constexpr float RangeSeconds[5] = {5, 10, 40, 40, 120};
 constexpr float DcRemovalHz = 7.f;
 constexpr float SatuSafeVol = 16.f;
 constexpr float SatuStrength = 0.001f;
+constexpr int WindowTableSize = 4096;
+constexpr int PitchUpdateInterval = 32;// samples between glide/automation updates
 
 
 class GranularPitchShifterEffect : public Effect
@@ -109,6 +111,13 @@ public:
 	
 	void changeSampleRate();
 
+	float windowAt(double phase) const
+	{
+		const float pos = static_cast<float>(phase) * WindowTableSize;
+		const int index = static_cast<int>(pos);
+		return linearInterpolate(m_windowTable[index], m_windowTable[index + 1], pos - index);
+	}
+
 private:
 	struct PrefilterLowpass
 	{
@@ -136,6 +145,10 @@ private:
 		}
 	};
 
+	void updateWindowTable(float shape, float fadeLength);
+	int safeSegmentLength(int maxLength) const;
+	void renderGrains(int length);
+
 	struct Grain
 	{
 		Grain(double grainSpeedL, double grainSpeedR, double phaseSpeedL, double phaseSpeedR, double readPointL, double readPointR) :
@@ -155,6 +168,13 @@ private:
 	std::vector<std::array<float, 2>> m_ringBuf;
 	std::vector<Grain> m_grains;
 
+	// per-period scratch buffers, so grains can be rendered one after another
+	std::vector<std::array<float, 2>> m_grainBuf;
+	std::vector<float> m_windowBuf;
+	std::array<float, WindowTableSize + 1> m_windowTable;
+	float m_windowShape = -1;
+	float m_windowFadeLength = -1;
+
 	std::array<PrefilterLowpass, 2> m_prefilter;
 	std::array<double, 2> m_speed = {1, 1};
 	std::array<double, 2> m_truePitch = {0, 0};
@@ -169,6 +189,7 @@ private:
 	int m_writePoint = 0;
 	int m_grainCount = 0;
 	int m_timeSinceLastGrain = 999999999;
+	int m_glideStepsPending = 0;
 
 	double m_oldGlide = -1;
 	double m_glideCoef = 0;
@@ -1,5 +1,7 @@
 #include <QDomDocument>
 
+#include <vector>
+
 #include "LocalFileMng.h"
 #include "HydrogenImport.h"
 #include "Song.h"
@@ -9,6 +11,7 @@
 #include "Note.h"
 #include "MidiClip.h"
 #include "PatternStore.h"
+#include "SampleLoader.h"
 #include "Track.h"
 
 #include "plugin_export.h"
@@ -134,10 +137,27 @@ HydrogenImport::HydrogenImport( const QString & _file ) :
 
 
 
+namespace
+{
+
+struct DrumInstrument
+{
+	QString id;
+	QString sampleFile;
+	float volume;
+	float panning;
+};
+
+} // namespace
+
+
+
+
 Instrument * ins;
 bool HydrogenImport::readSong() 
 {
 	QHash<QString, InstrumentTrack *> drum_track;
+	std::vector<DrumInstrument> drum_instruments;
 	QHash<QString, int> pattern_length;
 	QHash<QString, int> pattern_id;
 
@@ -217,13 +237,7 @@ bool HydrogenImport::readSong()
 
 					if ( nLayer == 0 ) 
 					{
-						drum_track[sId] = static_cast<InstrumentTrack*>(
-							Track::create(Track::Type::Instrument, Engine::patternStore())
-						);
-						drum_track[sId]->volumeModel()->setValue( fVolume * 100 );
-						drum_track[sId]->panningModel()->setValue( ( fPan_R - fPan_L ) * 100 );
-						ins = drum_track[sId]->loadInstrument( "audiofileprocessor" );
-						ins->loadFile( sFilename );
+						drum_instruments.push_back({ sId, sFilename, fVolume * 100, ( fPan_R - fPan_L ) * 100 });
 					}
 					nLayer++;
 					layerNode = ( QDomNode ) layerNode.nextSiblingElement( "layer" );
@@ -236,6 +250,28 @@ bool HydrogenImport::readSong()
 		{
 			return false;
 		}
+
+		// Decode all samples in parallel instead of one after another while creating the tracks
+		QStringList sampleFiles;
+		for( const auto& instrument : drum_instruments )
+		{
+			sampleFiles << instrument.sampleFile;
+		}
+		gui::SampleLoader::preloadFiles( sampleFiles );
+
+		for( const auto& instrument : drum_instruments )
+		{
+			auto track = static_cast<InstrumentTrack*>(
+				Track::create(Track::Type::Instrument, Engine::patternStore())
+			);
+			track->volumeModel()->setValue( instrument.volume );
+			track->panningModel()->setValue( instrument.panning );
+			ins = track->loadInstrument( "audiofileprocessor" );
+			ins->loadFile( instrument.sampleFile );
+			drum_track[instrument.id] = track;
+		}
+
+		gui::SampleLoader::releasePreloadedBuffers();
 	} 
 	else 
 	{
@@ -264,6 +300,8 @@ bool HydrogenImport::readSong()
 		pattern_length[sName] = nSize;
 		QDomNode pNoteListNode = patternNode.firstChildElement( "noteList" );
 		if ( ! pNoteListNode.isNull() ) {
+			// Collected per instrument, so every clip is updated once
+			QHash<QString, std::vector<Note>> clip_notes;
 			QDomNode noteNode = pNoteListNode.firstChildElement( "note" );
 			while ( ! noteNode.isNull()  ) {
 				int nPosition = LocalFileMng::readXmlInt( noteNode, "position", 0 );
@@ -274,9 +312,7 @@ bool HydrogenImport::readSong()
 				QString nNoteOff = LocalFileMng::readXmlString( noteNode, "note_off", "false", false, false );
 
 				QString instrId = LocalFileMng::readXmlString( noteNode, "instrument", 0,false, false );
-				int i = pattern_count - 1 + existing_patterns;
 				pattern_id[sName] = pattern_count - 1;
-				auto p = dynamic_cast<MidiClip*>(drum_track[instrId]->getClip(i));
 				Note n; 
 				n.setPos( nPosition );
 				if ( (nPosition + 48) <= nSize ) 
@@ -290,10 +326,17 @@ bool HydrogenImport::readSong()
 				n.setVolume( fVelocity * 100 );
 				n.setPanning( ( fPan_R - fPan_L ) * 100 );
 				n.setKey( NoteKey::stringToNoteKey( sKey ) );
-				p->addNote( n,false );
+				clip_notes[instrId].push_back( n );
 				pn = pn + 1;
 				noteNode = ( QDomNode ) noteNode.nextSiblingElement( "note" );
-			}        
+			}
+
+			int i = pattern_count - 1 + existing_patterns;
+			for( auto it = clip_notes.begin(); it != clip_notes.end(); ++it )
+			{
+				auto p = dynamic_cast<MidiClip*>(drum_track[it.key()]->getClip(i));
+				p->addNotes( it.value() );
+			}
 		}
 		patternNode = ( QDomNode ) patternNode.nextSiblingElement( "pattern" );
 	}
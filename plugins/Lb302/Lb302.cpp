@@ -30,7 +30,10 @@
 
 // Need to include this first to ensure we get M_PI in MinGW with C++11
 #define _USE_MATH_DEFINES
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <vector>
 
 #include "Lb302.h"
 #include "AutomatableButton.h"
@@ -94,6 +97,47 @@ Plugin::Descriptor PLUGIN_EXPORT lb302_plugin_descriptor =
 
 }
 
+//
+// Coefficient cache
+//
+
+/*  envRecalc() computes exp(-w/vcf_rescoeff) every ENVINC samples while a note
+ *  plays. The argument is positive and rarely large, so it is looked up in a
+ *  table with linear interpolation, which is accurate to about 2e-6.
+ */
+class Lb302NegExpTable
+{
+public:
+	Lb302NegExpTable() :
+		m_values(static_cast<std::size_t>(MaxArg * StepsPerUnit) + 2)
+	{
+		for (std::size_t i = 0; i < m_values.size(); ++i)
+		{
+			m_values[i] = static_cast<float>(std::exp(-static_cast<double>(i) / StepsPerUnit));
+		}
+	}
+
+	//! exp(-x)
+	float operator()(float x) const
+	{
+		if (!(x >= 0.f && x < MaxArg)) { return std::exp(-x); }
+
+		const float pos = x * StepsPerUnit;
+		const auto index = static_cast<std::size_t>(pos);
+		const float frac = pos - index;
+		return m_values[index] + frac * (m_values[index + 1] - m_values[index]);
+	}
+
+private:
+	static constexpr int StepsPerUnit = 256;
+	static constexpr float MaxArg = 16.f; // exp(-16) is about 1e-7
+
+	std::vector<float> m_values;
+};
+
+const Lb302NegExpTable negExp;
+
+
 //
 // Lb302Filter
 //
@@ -169,7 +213,7 @@ void Lb302FilterIIR2::envRecalc()
 	Lb302Filter::envRecalc();
 
 	float w = vcf_e0 + vcf_c0;          // e0 is adjusted for Hz and doesn't need ENVINC
-	float k = exp(-w/vcf_rescoeff);     // Does this mean c0 is inheritantly?
+	float k = negExp(w/vcf_rescoeff);   // Does this mean c0 is inheritantly?
 
 	vcf_a = 2.0*cos(2.0*w) * k;
 	vcf_b = -k*k;
@@ -177,6 +221,15 @@ void Lb302FilterIIR2::envRecalc()
 }
 
 
+void Lb302FilterIIR2::processBlock(float* samples, int count)
+{
+	for (int i = 0; i < count; ++i)
+	{
+		samples[i] = Lb302FilterIIR2::process(samples[i]);
+	}
+}
+
+
 float Lb302FilterIIR2::process(const float& samp)
 {
 	float ret = vcf_a*vcf_d1 + vcf_b*vcf_d2 + vcf_c*samp;
@@ -241,7 +294,7 @@ void Lb302Filter3Pole::envRecalc()
 	kp1  = kp+1.0;
 	kp1h = 0.5*kp1;
 #ifdef LB_24_RES_TRICK
-	k = exp(-w/vcf_rescoeff);
+	k = negExp(w/vcf_rescoeff);
 	kres = (((k))) * (((-2.7079*kp1 + 10.963)*kp1 - 14.934)*kp1 + 8.4974);
 #else
 	kres = (((fs->reso))) * (((-2.7079*kp1 + 10.963)*kp1 - 14.934)*kp1 + 8.4974);
@@ -250,6 +303,15 @@ void Lb302Filter3Pole::envRecalc()
 }
 
 
+void Lb302Filter3Pole::processBlock(float* samples, int count)
+{
+	for (int i = 0; i < count; ++i)
+	{
+		samples[i] = Lb302Filter3Pole::process(samples[i]);
+	}
+}
+
+
 float Lb302Filter3Pole::process(const float& samp)
 {
 	float ax1  = lastin;
@@ -497,15 +559,31 @@ int Lb302Synth::process(sampleFrame *outbuf, const int size)
 	// At 44.1 kHz this will compute something very close to the previously
 	// hard coded value of 0.99897516.
 	auto decay = computeDecayFactor(0.245260770975f, 1.f / 65536.f);
+	const float attackFrames = 0.5f * Engine::audioEngine()->outputSampleRate();
+
+	switch(int(rint(wave_shape.value()))) {
+		case 0: vco_shape = VcoShape::Sawtooth; break;
+		case 1: vco_shape = VcoShape::Triangle; break;
+		case 2: vco_shape = VcoShape::Square; break;
+		case 3: vco_shape = VcoShape::RoundSquare; break;
+		case 4: vco_shape = VcoShape::Moog; break;
+		case 5: vco_shape = VcoShape::Sine; break;
+		case 6: vco_shape = VcoShape::Exponential; break;
+		case 7: vco_shape = VcoShape::WhiteNoise; break;
+		case 8: vco_shape = VcoShape::BLSawtooth; break;
+		case 9: vco_shape = VcoShape::BLSquare; break;
+		case 10: vco_shape = VcoShape::BLTriangle; break;
+		case 11: vco_shape = VcoShape::BLMoog; break;
+		default:  vco_shape = VcoShape::Sawtooth; break;
+	}
 
-	for( int i=0; i<size; i++ ) 
-	{
-		// start decay if we're past release
-		if( i >= release_frame )
-		{
-			vca_mode = VcaMode::Decay;
-		}
+	// The period is processed in chunks between envelope updates. Within a chunk the
+	// filter coefficients and vco_inc are constant, so the VCO, the filter and the VCA
+	// can each run over the whole chunk, with only one virtual filter call per chunk.
+	std::array<float, ENVINC> chunkBuf;
 
+	for( int i=0; i<size; ) 
+	{
 		// update vcf
 		if(vcf_envpos >= ENVINC) {
 			filter->envRecalc();
@@ -520,147 +598,124 @@ int Lb302Synth::process(sampleFrame *outbuf, const int size)
 			}
 		}
 
+		const int chunk = std::min( ENVINC - vcf_envpos, size - i );
+		vcf_envpos += chunk;
 
-		sample_cnt++;
-		vcf_envpos++;
-
-		//int  decay_frames = 128;
-
-		// update vco
-		vco_c += vco_inc;
-		
-		if(vco_c > 0.5)
-			vco_c -= 1.0;
-
-		switch(int(rint(wave_shape.value()))) {
-			case 0: vco_shape = VcoShape::Sawtooth; break;
-			case 1: vco_shape = VcoShape::Triangle; break;
-			case 2: vco_shape = VcoShape::Square; break;
-			case 3: vco_shape = VcoShape::RoundSquare; break;
-			case 4: vco_shape = VcoShape::Moog; break;
-			case 5: vco_shape = VcoShape::Sine; break;
-			case 6: vco_shape = VcoShape::Exponential; break;
-			case 7: vco_shape = VcoShape::WhiteNoise; break;
-			case 8: vco_shape = VcoShape::BLSawtooth; break;
-			case 9: vco_shape = VcoShape::BLSquare; break;
-			case 10: vco_shape = VcoShape::BLTriangle; break;
-			case 11: vco_shape = VcoShape::BLMoog; break;
-			default:  vco_shape = VcoShape::Sawtooth; break;
-		}
+		for( int j = 0; j < chunk; j++ )
+		{
+			// update vco
+			vco_c += vco_inc;
+
+			if(vco_c > 0.5)
+				vco_c -= 1.0;
+
+			// add vco_shape_param the changes the shape of each curve.
+			// merge sawtooths with triangle and square with round square?
+			switch (vco_shape) {
+				case VcoShape::Sawtooth: // p0: curviness of line
+					vco_k = vco_c;  // Is this sawtooth backwards?
+					break;
+
+				case VcoShape::Triangle:  // p0: duty rev.saw<->triangle<->saw p1: curviness
+					vco_k = (vco_c*2.0)+0.5;
+					if (vco_k>0.5)
+						vco_k = 1.0- vco_k;
+					break;
+
+				case VcoShape::Square: // p0: slope of top
+					vco_k = (vco_c<0)?0.5:-0.5;
+					break;
+
+				case VcoShape::RoundSquare: // p0: width of round
+					vco_k = (vco_c<0)?(sqrtf(1-(vco_c*vco_c*4))-0.5):-0.5;
+					break;
+
+				case VcoShape::Moog: // Maybe the fall should be exponential/sinsoidal instead of quadric.
+					// [-0.5, 0]: Rise, [0,0.25]: Slope down, [0.25,0.5]: Low
+					vco_k = (vco_c*2.0)+0.5;
+					if (vco_k>1.0) {
+						vco_k = -0.5 ;
+					}
+					else if (vco_k>0.5) {
+						float w = 2.0 * (vco_k - 0.5) - 1.0;
+						vco_k = 0.5 - sqrtf(1.0-(w*w));
+					}
+					vco_k *= 2.0;  // MOOG wave gets filtered away
+					break;
+
+				case VcoShape::Sine:
+					// [-0.5, 0.5]  : [-pi, pi]
+					vco_k = 0.5f * Oscillator::sinSample( vco_c );
+					break;
+
+				case VcoShape::Exponential:
+					vco_k = 0.5 * Oscillator::expSample( vco_c );
+					break;
+
+				case VcoShape::WhiteNoise:
+					vco_k = 0.5 * Oscillator::noiseSample( vco_c );
+					break;
+
+				// The next cases all use the BandLimitedWave class which uses the oscillator increment `vco_inc` to compute samples.
+				// If that oscillator increment is 0 we return a 0 sample because calling BandLimitedWave::pdToLen(0) leads to a
+				// division by 0 which in turn leads to floating point exceptions.
+				case VcoShape::BLSawtooth:
+					vco_k = vco_inc == 0. ? 0. : BandLimitedWave::oscillate(vco_c + 0.5f, BandLimitedWave::pdToLen(vco_inc), BandLimitedWave::Waveform::BLSaw) * 0.5f;
+					break;
+
+				case VcoShape::BLSquare:
+					vco_k = vco_inc == 0. ? 0. : BandLimitedWave::oscillate(vco_c + 0.5f, BandLimitedWave::pdToLen(vco_inc), BandLimitedWave::Waveform::BLSquare) * 0.5f;
+					break;
+
+				case VcoShape::BLTriangle:
+					vco_k = vco_inc == 0. ? 0. : BandLimitedWave::oscillate(vco_c + 0.5f, BandLimitedWave::pdToLen(vco_inc), BandLimitedWave::Waveform::BLTriangle) * 0.5f;
+					break;
+
+				case VcoShape::BLMoog:
+					vco_k = vco_inc == 0. ? 0. : BandLimitedWave::oscillate(vco_c + 0.5f, BandLimitedWave::pdToLen(vco_inc), BandLimitedWave::Waveform::BLMoog);
+					break;
+			}
 
-		// add vco_shape_param the changes the shape of each curve.
-		// merge sawtooths with triangle and square with round square?
-		switch (vco_shape) {
-			case VcoShape::Sawtooth: // p0: curviness of line
-				vco_k = vco_c;  // Is this sawtooth backwards?
-				break;
-
-			case VcoShape::Triangle:  // p0: duty rev.saw<->triangle<->saw p1: curviness
-				vco_k = (vco_c*2.0)+0.5;
-				if (vco_k>0.5)
-					vco_k = 1.0- vco_k;
-				break;
-
-			case VcoShape::Square: // p0: slope of top
-				vco_k = (vco_c<0)?0.5:-0.5;
-				break;
-
-			case VcoShape::RoundSquare: // p0: width of round
-				vco_k = (vco_c<0)?(sqrtf(1-(vco_c*vco_c*4))-0.5):-0.5;
-				break;
-
-			case VcoShape::Moog: // Maybe the fall should be exponential/sinsoidal instead of quadric.
-				// [-0.5, 0]: Rise, [0,0.25]: Slope down, [0.25,0.5]: Low
-				vco_k = (vco_c*2.0)+0.5;
-				if (vco_k>1.0) {
-					vco_k = -0.5 ;
-				}
-				else if (vco_k>0.5) {
-					float w = 2.0 * (vco_k - 0.5) - 1.0;
-					vco_k = 0.5 - sqrtf(1.0-(w*w));
-				}
-				vco_k *= 2.0;  // MOOG wave gets filtered away
-				break;
-
-			case VcoShape::Sine:
-				// [-0.5, 0.5]  : [-pi, pi]
-				vco_k = 0.5f * Oscillator::sinSample( vco_c );
-				break;
-
-			case VcoShape::Exponential:
-				vco_k = 0.5 * Oscillator::expSample( vco_c );
-				break;
-
-			case VcoShape::WhiteNoise:
-				vco_k = 0.5 * Oscillator::noiseSample( vco_c );
-				break;
-
-			// The next cases all use the BandLimitedWave class which uses the oscillator increment `vco_inc` to compute samples.
-			// If that oscillator increment is 0 we return a 0 sample because calling BandLimitedWave::pdToLen(0) leads to a
-			// division by 0 which in turn leads to floating point exceptions.
-			case VcoShape::BLSawtooth:
-				vco_k = vco_inc == 0. ? 0. : BandLimitedWave::oscillate(vco_c + 0.5f, BandLimitedWave::pdToLen(vco_inc), BandLimitedWave::Waveform::BLSaw) * 0.5f;
-				break;
-
-			case VcoShape::BLSquare:
-				vco_k = vco_inc == 0. ? 0. : BandLimitedWave::oscillate(vco_c + 0.5f, BandLimitedWave::pdToLen(vco_inc), BandLimitedWave::Waveform::BLSquare) * 0.5f;
-				break;
-
-			case VcoShape::BLTriangle:
-				vco_k = vco_inc == 0. ? 0. : BandLimitedWave::oscillate(vco_c + 0.5f, BandLimitedWave::pdToLen(vco_inc), BandLimitedWave::Waveform::BLTriangle) * 0.5f;
-				break;
-
-			case VcoShape::BLMoog:
-				vco_k = vco_inc == 0. ? 0. : BandLimitedWave::oscillate(vco_c + 0.5f, BandLimitedWave::pdToLen(vco_inc), BandLimitedWave::Waveform::BLMoog);
-				break;
+			chunkBuf[j] = vco_k;
 		}
 
-		//vca_a = 0.5;
-		// Write out samples.
 #ifdef LB_FILTERED
-		//samp = vcf->process(vco_k)*2.0*vca_a;
-		//samp = vcf->process(vco_k)*2.0;
-		float samp = filter->process(vco_k) * vca_a;
-		//printf("%f %d\n", vco_c, sample_cnt);
-
-
-		//samp = vco_k * vca_a;
+		filter->processBlock( chunkBuf.data(), chunk );
+#endif
 
-		if( sample_cnt <= 4 )
+		for( int j = 0; j < chunk; j++, i++ )
 		{
-	//			vca_a = 0;
-		}
+			// start decay if we're past release
+			if( i >= release_frame )
+			{
+				vca_mode = VcaMode::Decay;
+			}
 
-#else
-		//samp = vco_k*vca_a;
-#endif
-		/*
-		float releaseFrames = desiredReleaseFrames();
-		samp *= (releaseFrames - catch_decay)/releaseFrames;
-		*/
-		//LB302 samp *= (float)(decay_frames - catch_decay)/(float)decay_frames;
+			sample_cnt++;
 
-		for( int c = 0; c < DEFAULT_CHANNELS; c++ ) 
-		{
-			outbuf[i][c] = samp;
-		}
+			// Write out samples.
+			const float samp = chunkBuf[j] * vca_a;
+			for( int c = 0; c < DEFAULT_CHANNELS; c++ ) 
+			{
+				outbuf[i][c] = samp;
+			}
 
-		// Handle Envelope
-		if(vca_mode==VcaMode::Attack) {
-			vca_a+=(vca_a0-vca_a)*vca_attack;
-			if(sample_cnt>=0.5*Engine::audioEngine()->outputSampleRate())
-				vca_mode = VcaMode::Idle;
-		}
-		else if(vca_mode == VcaMode::Decay) {
-			vca_a *= decay;
+			// Handle Envelope
+			if(vca_mode==VcaMode::Attack) {
+				vca_a+=(vca_a0-vca_a)*vca_attack;
+				if(sample_cnt>=attackFrames)
+					vca_mode = VcaMode::Idle;
+			}
+			else if(vca_mode == VcaMode::Decay) {
+				vca_a *= decay;
 
-			// the following line actually speeds up processing
-			if(vca_a < (1/65536.0)) {
-				vca_a = 0;
-				vca_mode = VcaMode::NeverPlayed;
+				// the following line actually speeds up processing
+				if(vca_a < (1/65536.0)) {
+					vca_a = 0;
+					vca_mode = VcaMode::NeverPlayed;
+				}
 			}
 		}
-
 	}
 	return 1;
 }
@@ -76,6 +76,8 @@ class Lb302Filter
 	virtual void recalc();
 	virtual void envRecalc();
 	virtual float process(const float& samp)=0;
+	//! Filters @p count samples in place, without a virtual call per sample
+	virtual void processBlock(float* samples, int count)=0;
 	virtual void playNote();
 
 	protected:
@@ -97,6 +99,7 @@ class Lb302FilterIIR2 : public Lb302Filter
 	void recalc() override;
 	void envRecalc() override;
 	float process(const float& samp) override;
+	void processBlock(float* samples, int count) override;
 
 	protected:
 	float vcf_d1,           //   d1 and d2 are added back into the sample with
@@ -121,6 +124,7 @@ class Lb302Filter3Pole : public Lb302Filter
 	void envRecalc() override;
 	void recalc() override;
 	float process(const float& samp) override;
+	void processBlock(float* samples, int count) override;
 
 	protected:
 	float kfcn,
@@ -27,11 +27,15 @@
 
 #include "MidiExport.h"
 
+#include <QFile>
+#include <algorithm>
+#include <climits>
+#include <queue>
+
 #include "Engine.h"
 #include "TrackContainer.h"
-#include "DataFile.h"
 #include "InstrumentTrack.h"
-#include "LocaleHelper.h"
+#include "MidiClip.h"
 #include "PatternTrack.h"
 
 #include "plugin_export.h"
@@ -76,9 +80,6 @@ bool MidiExport::tryExport(const TrackContainer::TrackList &tracks,
 	f.open(QIODevice::WriteOnly);
 	QDataStream midiout(&f);
 
-	QDomElement element;
-
-
 	int nTracks = 0;
 	auto buffer = std::array<uint8_t, BUFFER_SIZE>{};
 
@@ -95,162 +96,100 @@ bool MidiExport::tryExport(const TrackContainer::TrackList &tracks,
 	// midi tracks
 	for (Track* track : tracks)
 	{
-		DataFile dataFile(DataFile::Type::SongProject);
-		MTrack mtrack;
-
 		if (track->type() == Track::Type::Instrument)
 		{
-
+			MTrack mtrack;
 			mtrack.addName(track->name().toStdString(), 0);
 			//mtrack.addProgramChange(0, 0);
 			mtrack.addTempo(tempo, 0);
 
-			auto instTrack = dynamic_cast<InstrumentTrack *>(track);
-			element = instTrack->saveState(dataFile, dataFile.content());
-
-			int base_pitch = 0;
-			double base_volume = 1.0;
-			int base_time = 0;
+			const auto instTrack = dynamic_cast<InstrumentTrack*>(track);
+			writeSongTrack(mtrack, instTrack, trackSettings(instTrack, masterPitch));
 
-			MidiNoteVector midiClip;
-
-			for (QDomNode n = element.firstChild(); !n.isNull(); n = n.nextSibling())
-			{
-
-				if (n.nodeName() == "instrumenttrack")
-				{
-					QDomElement it = n.toElement();
-					base_pitch = (69 - it.attribute("basenote", "69").toInt());
-					if (it.attribute("usemasterpitch", "1").toInt())
-					{
-						base_pitch += masterPitch;
-					}
-					base_volume = LocaleHelper::toDouble(it.attribute("volume", "100"))/100.0;
-				}
-
-				if (n.nodeName() == "midiclip")
-				{
-					base_time = n.toElement().attribute("pos", "0").toInt();
-					writeMidiClip(midiClip, n, base_pitch, base_volume, base_time);
-				}
-
-			}
-			processPatternNotes(midiClip, INT_MAX);
-			writeMidiClipToTrack(mtrack, midiClip);
 			size = mtrack.writeToBuffer(buffer.data());
 			midiout.writeRawData((char *)buffer.data(), size);
 		}
 
 		if (track->type() == Track::Type::Pattern)
 		{
-			auto patternTrack = dynamic_cast<PatternTrack*>(track);
-			element = patternTrack->saveState(dataFile, dataFile.content());
-
 			std::vector<std::pair<int,int>> plist;
-			for (QDomNode n = element.firstChild(); !n.isNull(); n = n.nextSibling())
+			for (const Clip* clip : track->getClips())
 			{
-
-				if (n.nodeName() == "patternclip")
-				{
-					QDomElement it = n.toElement();
-					int pos = it.attribute("pos", "0").toInt();
-					int len = it.attribute("len", "0").toInt();
-					plist.emplace_back(pos, pos+len);
-				}
+				const int pos = clip->startPosition();
+				plist.emplace_back(pos, pos + clip->length());
 			}
 			std::sort(plist.begin(), plist.end());
 			plists.push_back(plist);
-
 		}
 	} // for each track
 
 	// for each instrument in the pattern editor
 	for (Track* track : patternStoreTracks)
 	{
-		DataFile dataFile(DataFile::Type::SongProject);
-		MTrack mtrack;
-
-		// begin at the first pattern track (first pattern)
-		auto itr = plists.begin();
-
-		std::vector<std::pair<int,int>> st;
-
 		if (track->type() != Track::Type::Instrument) continue;
 
+		MTrack mtrack;
 		mtrack.addName(track->name().toStdString(), 0);
 		//mtrack.addProgramChange(0, 0);
 		mtrack.addTempo(tempo, 0);
 
-		auto instTrack = dynamic_cast<InstrumentTrack *>(track);
-		element = instTrack->saveState(dataFile, dataFile.content());
-
-		int base_pitch = 0;
-		double base_volume = 1.0;
+		const auto instTrack = dynamic_cast<InstrumentTrack*>(track);
+		const auto settings = trackSettings(instTrack, masterPitch);
 
-		// for each pattern in the pattern editor
-		for (QDomNode n = element.firstChild(); !n.isNull(); n = n.nextSibling())
+		// the clips of the track are the patterns, in the order of the pattern tracks
+		auto itr = plists.begin();
+		for (const Clip* clip : track->getClips())
 		{
-			if (n.nodeName() == "instrumenttrack")
-			{
-				QDomElement it = n.toElement();
-				base_pitch = (69 - it.attribute("basenote", "69").toInt());
-				if (it.attribute("usemasterpitch", "1").toInt())
-				{
-					base_pitch += masterPitch;
-				}
-				base_volume = LocaleHelper::toDouble(it.attribute("volume", "100")) / 100.0;
-			}
+			if (itr == plists.end()) { break; }
+			const std::vector<std::pair<int,int>> &plist = *itr;
+			++itr;
 
-			if (n.nodeName() == "midiclip")
-			{
-				std::vector<std::pair<int,int>> &plist = *itr;
+			const auto midiClip = dynamic_cast<const MidiClip*>(clip);
+			if (!midiClip || plist.empty()) { continue; }
 
-				MidiNoteVector nv, midiClip;
-				writeMidiClip(midiClip, n, base_pitch, base_volume, 0);
+			const int len = midiClip->steps() * 12;
 
+			// Step notes are cut at the end of the last pattern clip
+			int cutPos = 0;
+			for (const auto& position : plist) { cutPos = std::max(cutPos, position.second); }
+			NoteWriter writer(mtrack, cutPos);
 
-				// FIXME better variable names and comments
-				int pos = 0;
-				int len = n.toElement().attribute("steps", "1").toInt() * 12;
+			// Resolve overlapping pattern clips (in song editor) into segments in
+			// time order, each one playing the pattern from the start of its clip
+			std::vector<std::pair<int,int>> st;
+			int pos = 0;
+			for (const auto& position : plist)
+			{
+				const auto& [start, end] = position;
+				while (!st.empty() && st.back().second <= start)
+				{
+					writePatternSegment(writer, midiClip, settings, len, st.back().first, pos, st.back().second);
+					pos = st.back().second;
+					st.pop_back();
+				}
 
-				// for each pattern clip of the current pattern track (in song editor)
-				for (const auto& position : plist)
+				if (!st.empty() && st.back().second <= end)
 				{
-					const auto& [start, end] = position;
-					while (!st.empty() && st.back().second <= start)
+					writePatternSegment(writer, midiClip, settings, len, st.back().first, pos, start);
+					pos = start;
+					while (!st.empty() && st.back().second <= end)
 					{
-						writePatternClip(midiClip, nv, len, st.back().first, pos, st.back().second);
-						pos = st.back().second;
 						st.pop_back();
 					}
-
-					if (!st.empty() && st.back().second <= end)
-					{
-						writePatternClip(midiClip, nv, len, st.back().first, pos, start);
-						pos = start;
-						while (!st.empty() && st.back().second <= end)
-						{
-							st.pop_back();
-						}
-					}
-
-					st.push_back(position);
-					pos = start;
-				}
-
-				while (!st.empty())
-				{
-					writePatternClip(midiClip, nv, len, st.back().first, pos, st.back().second);
-					pos = st.back().second;
-					st.pop_back();
 				}
 
-				processPatternNotes(nv, pos);
-				writeMidiClipToTrack(mtrack, nv);
+				st.push_back(position);
+				pos = start;
+			}
 
-				// next pattern track
-				++itr;
+			while (!st.empty())
+			{
+				writePatternSegment(writer, midiClip, settings, len, st.back().first, pos, st.back().second);
+				pos = st.back().second;
+				st.pop_back();
 			}
+
+			writer.finish();
 		}
 		size = mtrack.writeToBuffer(buffer.data());
 		midiout.writeRawData((char *)buffer.data(), size);
@@ -262,78 +201,159 @@ bool MidiExport::tryExport(const TrackContainer::TrackList &tracks,
 
 
 
-void MidiExport::writeMidiClip(MidiNoteVector &midiClip, const QDomNode& n,
-				int base_pitch, double base_volume, int base_time)
+MidiExport::TrackSettings MidiExport::trackSettings(InstrumentTrack* track, int masterPitch)
 {
-	// TODO interpret steps="12" muted="0" type="1" name="Piano1"  len="2592"
-	for (QDomNode nn = n.firstChild(); !nn.isNull(); nn = nn.nextSibling())
+	auto settings = TrackSettings{};
+	settings.basePitch = 69 - track->baseNoteModel()->value();
+	if (track->useMasterPitchModel()->value())
 	{
-		QDomElement note = nn.toElement();
-		if (note.attribute("len", "0") == "0") continue;
-		// TODO interpret pan="0" mixch="0" pitchrange="1"
-		MidiNote mnote;
-		mnote.pitch = qMax(0, qMin(127, note.attribute("key", "0").toInt() + base_pitch));
-		 // Map from LMMS volume to MIDI velocity
-		mnote.volume = qMin(qRound(base_volume * LocaleHelper::toDouble(note.attribute("vol", "100")) * (127.0 / 200.0)), 127);
-		mnote.time = base_time + note.attribute("pos", "0").toInt();
-		mnote.duration = note.attribute("len", "0").toInt();
-		mnote.type = static_cast<Note::Type>(note.attribute("type", "0").toInt());
-		midiClip.push_back(mnote);
+		settings.basePitch += masterPitch;
 	}
+	settings.baseVolume = track->volumeModel()->value() / 100.0;
+	return settings;
 }
 
 
 
-void MidiExport::writeMidiClipToTrack(MTrack &mtrack, MidiNoteVector &nv)
+MidiNote MidiExport::toMidiNote(const Note* note, const TrackSettings& settings, int time)
 {
-	for (const auto& note : nv)
+	// TODO interpret panning, mixer channel and pitch range
+	MidiNote mnote;
+	mnote.pitch = qMax(0, qMin(127, note->key() + settings.basePitch));
+	// Map from LMMS volume to MIDI velocity
+	mnote.volume = qMin(qRound(settings.baseVolume * note->getVolume() * (127.0 / 200.0)), 127);
+	mnote.time = time;
+	mnote.duration = note->length();
+	mnote.type = note->type();
+	return mnote;
+}
+
+
+
+void MidiExport::writeSongTrack(MTrack& mtrack, const InstrumentTrack* track, const TrackSettings& settings)
+{
+	// The notes of every clip are sorted already, so the clips only have to be merged
+	struct ClipCursor
 	{
-		mtrack.addNote(note.pitch, note.volume, note.time / 48.0, note.duration / 48.0);
+		NoteVector::const_iterator note;
+		NoteVector::const_iterator end;
+		int base;
+
+		int time() const { return base + (*note)->pos(); }
+		void skipEmpty()
+		{
+			while (note != end && (*note)->length() == 0) { ++note; }
+		}
+	};
+	const auto later = [](const ClipCursor& a, const ClipCursor& b) { return a.time() > b.time(); };
+	auto queue = std::priority_queue<ClipCursor, std::vector<ClipCursor>, decltype(later)>{later};
+
+	for (const Clip* clip : track->getClips())
+	{
+		const auto midiClip = dynamic_cast<const MidiClip*>(clip);
+		if (!midiClip) { continue; }
+
+		auto cursor = ClipCursor{midiClip->notes().begin(), midiClip->notes().end(), midiClip->startPosition()};
+		cursor.skipEmpty();
+		if (cursor.note != cursor.end) { queue.push(cursor); }
+	}
+
+	NoteWriter writer(mtrack, INT_MAX);
+	while (!queue.empty())
+	{
+		auto cursor = queue.top();
+		queue.pop();
+		writer.add(toMidiNote(*cursor.note, settings, cursor.time()));
+
+		++cursor.note;
+		cursor.skipEmpty();
+		if (cursor.note != cursor.end) { queue.push(cursor); }
 	}
+	writer.finish();
 }
 
 
 
-void MidiExport::writePatternClip(MidiNoteVector& src, MidiNoteVector& dst,
+void MidiExport::writePatternSegment(NoteWriter& writer, const MidiClip* clip, const TrackSettings& settings,
 				int len, int base, int start, int end)
 {
-	if (start >= end) { return; }
+	if (start >= end || len <= 0) { return; }
 	start -= base;
 	end -= base;
-	std::sort(src.begin(), src.end());
-	for (const auto& srcNote : src)
+
+	// Every note of the pattern repeats each len ticks, which makes it a sorted stream
+	struct Repetition
+	{
+		const Note* note;
+		int time;
+	};
+	const auto later = [](const Repetition& a, const Repetition& b) { return a.time > b.time; };
+	auto queue = std::priority_queue<Repetition, std::vector<Repetition>, decltype(later)>{later};
+
+	for (const Note* note : clip->notes())
 	{
-		for (int time = srcNote.time + ceil((start - srcNote.time) / len) * len; time < end; time += len)
+		if (note->length() == 0) { continue; }
+
+		// first repetition at or after start
+		const int pos = note->pos();
+		int time = pos;
+		if (time < start)
 		{
-			MidiNote note;
-			note.duration = srcNote.duration;
-			note.pitch = srcNote.pitch;
-			note.time = base + time;
-			note.volume = srcNote.volume;
-			note.type = srcNote.type;
-			dst.push_back(note);
+			time += (start - pos + len - 1) / len * len;
 		}
+		if (time < end) { queue.push({note, time}); }
+	}
+
+	while (!queue.empty())
+	{
+		auto repetition = queue.top();
+		queue.pop();
+		writer.add(toMidiNote(repetition.note, settings, base + repetition.time));
+
+		repetition.time += len;
+		if (repetition.time < end) { queue.push(repetition); }
 	}
 }
 
 
 
-void MidiExport::processPatternNotes(MidiNoteVector& nv, int cutPos)
+MidiExport::NoteWriter::NoteWriter(MTrack& mtrack, int cutPos) :
+	m_mtrack(mtrack),
+	m_cutPos(cutPos)
+{
+}
+
+
+
+void MidiExport::NoteWriter::add(const MidiNote& note)
 {
-	std::sort(nv.begin(), nv.end());
-	int cur = INT_MAX, next = INT_MAX;
-	for (auto it = nv.rbegin(); it != nv.rend(); ++it)
+	if (!m_pending.empty() && m_pending.front().time < note.time)
 	{
-		if (it->time < cur)
-		{
-			next = cur;
-			cur = it->time;
-		}
-		if (it->type == Note::Type::Step)
+		flush(note.time);
+	}
+	m_pending.push_back(note);
+}
+
+
+
+void MidiExport::NoteWriter::finish()
+{
+	flush(INT_MAX);
+}
+
+
+
+void MidiExport::NoteWriter::flush(int next)
+{
+	for (auto& note : m_pending)
+	{
+		if (note.type == Note::Type::Step)
 		{
-			it->duration = qMin(qMin(DefaultBeatLength, next - cur), cutPos - it->time);
+			note.duration = qMin(qMin(DefaultBeatLength, next - note.time), m_cutPos - note.time);
 		}
+		m_mtrack.addNote(note.pitch, note.volume, note.time / 48.0, note.duration / 48.0);
 	}
+	m_pending.clear();
 }
 
 
@@ -27,13 +27,12 @@
 #define _MIDI_EXPORT_H
 
 #include <QString>
+#include <vector>
 
 #include "ExportFilter.h"
 #include "MidiFile.hpp"
 #include "Note.h"
 
-class QDomNode;
-
 namespace lmms
 {
 
@@ -55,8 +54,8 @@ struct MidiNote
 	}
 } ;
 
-using MidiNoteVector = std::vector<MidiNote>;
-using MidiNoteIterator = std::vector<MidiNote>::iterator;
+class InstrumentTrack;
+class MidiClip;
 
 class MidiExport: public ExportFilter
 {
@@ -85,12 +84,41 @@ public:
 				int tempo, int masterPitch, const QString &filename) override;
 	
 private:
-	void writeMidiClip(MidiNoteVector &midiClip, const QDomNode& n,
-				int base_pitch, double base_volume, int base_time);
-	void writeMidiClipToTrack(MTrack &mtrack, MidiNoteVector &nv);
-	void writePatternClip(MidiNoteVector &src, MidiNoteVector &dst,
+	//! Writes notes arriving in time order to a track. Step notes have no length
+	//! of their own, so they last until the next note starts, at most
+	//! DefaultBeatLength and not past cutPos.
+	class NoteWriter
+	{
+	public:
+		NoteWriter(MTrack& mtrack, int cutPos);
+		void add(const MidiNote& note);
+		void finish();
+
+	private:
+		void flush(int next);
+
+		MTrack& m_mtrack;
+		int m_cutPos;
+		//! Notes starting at the same time, waiting for the next note
+		std::vector<MidiNote> m_pending;
+	};
+
+	//! What the notes of a track are relative to
+	struct TrackSettings
+	{
+		int basePitch;
+		double baseVolume;
+	};
+
+	static TrackSettings trackSettings(InstrumentTrack* track, int masterPitch);
+	static MidiNote toMidiNote(const Note* note, const TrackSettings& settings, int time);
+
+	//! Writes the notes of all clips of a song editor track, merging the clips in time order
+	void writeSongTrack(MTrack& mtrack, const InstrumentTrack* track, const TrackSettings& settings);
+	//! Writes the repetitions of @p clip between @p start and @p end, the clip starting
+	//! over at @p base and every pattern length thereafter
+	void writePatternSegment(NoteWriter& writer, const MidiClip* clip, const TrackSettings& settings,
 				int len, int base, int start, int end);
-	void processPatternNotes(MidiNoteVector &nv, int cutPos);
 
 	void error();
 
@@ -26,6 +26,7 @@
 #include "Patman.h"
 
 #include <QDragEnterEvent>
+#include <QFileInfo>
 #include <QPainter>
 #include <QDomElement>
 
@@ -82,8 +83,14 @@ PLUGIN_EXPORT Plugin * lmms_plugin_main( Model *m, void * )
 PatmanInstrument::PatmanInstrument( InstrumentTrack * _instrument_track ) :
 	Instrument( _instrument_track, &patman_plugin_descriptor ),
 	m_loopedModel( true, this ),
-	m_tunedModel( true, this )
+	m_tunedModel( true, this ),
+	m_voices( std::make_unique<handle_data[]>( VoicePoolSize ) )
 {
+	m_freeVoices.reserve( VoicePoolSize );
+	for( std::size_t i = 0; i < VoicePoolSize; ++i )
+	{
+		m_freeVoices.push_back( &m_voices[i] );
+	}
 }
 
 
@@ -153,7 +160,7 @@ void PatmanInstrument::playNote( NotePlayHandle * _n,
 	float play_freq = hdata->tuned ? _n->frequency() :
 						hdata->sample->frequency();
 
-	if (hdata->sample->play(_working_buffer + offset, hdata->state, frames,
+	if (hdata->sample->play(_working_buffer + offset, &hdata->state, frames,
 					play_freq, m_loopedModel.value() ? Sample::Loop::On : Sample::Loop::Off))
 	{
 		applyRelease( _working_buffer, _n );
@@ -170,8 +177,20 @@ void PatmanInstrument::playNote( NotePlayHandle * _n,
 void PatmanInstrument::deleteNotePluginData( NotePlayHandle * _n )
 {
 	auto hdata = (handle_data*)_n->m_pluginData;
-	delete hdata->state;
-	delete hdata;
+	if( !hdata )
+	{
+		return;
+	}
+
+	hdata->sample.reset();
+	if( !hdata->pooled )
+	{
+		delete hdata;
+		return;
+	}
+
+	QMutexLocker locker( &m_voicePoolMutex );
+	m_freeVoices.push_back( hdata );
 }
 
 
@@ -215,6 +234,45 @@ PatmanInstrument::LoadError PatmanInstrument::loadPatch(
 {
 	unloadCurrentPatch();
 
+	const QFileInfo info( _filename );
+	const QString key = info.canonicalFilePath().isEmpty() ? _filename : info.canonicalFilePath();
+
+	{
+		QMutexLocker locker( &s_patchCacheMutex );
+		const auto it = s_patchCache.constFind( key );
+		if( it != s_patchCache.constEnd() && it->lastModified == info.lastModified()
+				&& it->size == info.size() )
+		{
+			if( auto samples = it->samples.lock() )
+			{
+				m_patchSamples = samples;
+				return( LoadError::OK );
+			}
+		}
+	}
+
+	PatchSamples samples;
+	const LoadError error = decodePatch( _filename, samples );
+	if( error != LoadError::OK )
+	{
+		return( error );
+	}
+
+	auto shared = std::make_shared<const PatchSamples>( std::move( samples ) );
+	{
+		QMutexLocker locker( &s_patchCacheMutex );
+		s_patchCache.insert( key, { info.lastModified(), info.size(), shared } );
+	}
+	m_patchSamples = shared;
+	return( LoadError::OK );
+}
+
+
+
+
+PatmanInstrument::LoadError PatmanInstrument::decodePatch(
+				const QString & _filename, PatchSamples & _samples )
+{
 	FILE * fd = fopen( _filename.toUtf8().constData() , "rb" );
 	if( !fd )
 	{
@@ -297,26 +355,28 @@ PatmanInstrument::LoadError PatmanInstrument::loadPatch(
 		// skip scale frequency, scale factor, reserved space
 		SKIP_BYTES( 2 + 2 + 36 );
 
+		// Decode straight into the frames of the sample buffer
 		f_cnt_t frames;
-		std::unique_ptr<sample_t[]> wave_samples;
+		std::vector<sampleFrame> data;
 		if( modes & MODES_16BIT )
 		{
 			frames = data_length >> 1;
-			wave_samples = std::make_unique<sample_t[]>(frames);
+			std::vector<short> raw( frames );
+			if( fread( raw.data(), 2, frames, fd ) != raw.size() )
+			{
+				fclose( fd );
+				return( LoadError::IO );
+			}
+
+			data.resize( frames );
 			for( f_cnt_t frame = 0; frame < frames; ++frame )
 			{
-				short sample;
-				if ( fread( &sample, 2, 1, fd ) != 1 )
-				{
-					fclose( fd );
-					return( LoadError::IO );
-				}
-				sample = swap16IfBE( sample );
+				short sample = swap16IfBE( raw[frame] );
 				if( modes & MODES_UNSIGNED )
 				{
 					sample ^= 0x8000;
 				}
-				wave_samples[frame] = sample / 32767.0f;
+				data[frame].fill( sample / 32767.0f );
 			}
 
 			loop_start >>= 1;
@@ -325,35 +385,27 @@ PatmanInstrument::LoadError PatmanInstrument::loadPatch(
 		else
 		{
 			frames = data_length;
-			wave_samples = std::make_unique<sample_t[]>(frames);
+			std::vector<char> raw( frames );
+			if( fread( raw.data(), 1, frames, fd ) != raw.size() )
+			{
+				fclose( fd );
+				return( LoadError::IO );
+			}
+
+			data.resize( frames );
 			for( f_cnt_t frame = 0; frame < frames; ++frame )
 			{
-				char sample;
-				if ( fread( &sample, 1, 1, fd ) != 1 )
-				{
-					fclose( fd );
-					return( LoadError::IO );
-				}
+				char sample = raw[frame];
 				if( modes & MODES_UNSIGNED )
 				{
 					sample ^= 0x80;
 				}
-				wave_samples[frame] = sample / 127.0f;
+				data[frame].fill( sample / 127.0f );
 			}
 		}
 
-		auto data = new sampleFrame[frames];
-
-		for( f_cnt_t frame = 0; frame < frames; ++frame )
-		{
-			for( ch_cnt_t chnl = 0; chnl < DEFAULT_CHANNELS;
-									++chnl )
-			{
-				data[frame][chnl] = wave_samples[frame];
-			}
-		}
-
-		auto psample = std::make_shared<Sample>(data, frames, sample_rate);
+		auto psample = std::make_shared<Sample>(
+			std::make_shared<const SampleBuffer>( std::move( data ), sample_rate ) );
 		psample->setFrequency(root_freq / 1000.0f);
 
 		if( modes & MODES_LOOPING )
@@ -362,9 +414,7 @@ PatmanInstrument::LoadError PatmanInstrument::loadPatch(
 			psample->setLoopEndFrame( loop_end );
 		}
 
-		m_patchSamples.push_back(psample);
-
-		delete[] data;
+		_samples.push_back(psample);
 	}
 	fclose( fd );
 	return( LoadError::OK );
@@ -375,10 +425,7 @@ PatmanInstrument::LoadError PatmanInstrument::loadPatch(
 
 void PatmanInstrument::unloadCurrentPatch()
 {
-	while( !m_patchSamples.empty() )
-	{
-		m_patchSamples.pop_back();
-	}
+	m_patchSamples.reset();
 }
 
 
@@ -391,23 +438,41 @@ void PatmanInstrument::selectSample( NotePlayHandle * _n )
 	float min_dist = HUGE_VALF;
 	std::shared_ptr<Sample> sample = nullptr;
 
-	for (const auto& patchSample : m_patchSamples)
+	if( const auto patchSamples = m_patchSamples )
 	{
-		float patch_freq = patchSample->frequency();
-		float dist = freq >= patch_freq ? freq / patch_freq :
-							patch_freq / freq;
+		for (const auto& patchSample : *patchSamples)
+		{
+			float patch_freq = patchSample->frequency();
+			float dist = freq >= patch_freq ? freq / patch_freq :
+								patch_freq / freq;
+
+			if( dist < min_dist )
+			{
+				min_dist = dist;
+				sample = patchSample;
+			}
+		}
+	}
 
-		if( dist < min_dist )
+	handle_data* hdata = nullptr;
+	{
+		QMutexLocker locker( &m_voicePoolMutex );
+		if( !m_freeVoices.empty() )
 		{
-			min_dist = dist;
-			sample = patchSample;
+			hdata = m_freeVoices.back();
+			m_freeVoices.pop_back();
 		}
 	}
+	if( !hdata )
+	{
+		hdata = new handle_data;
+		hdata->pooled = false;
+	}
 
-	auto hdata = new handle_data;
+	static const auto emptySample = std::make_shared<Sample>();
 	hdata->tuned = m_tunedModel.value();
-	hdata->sample = sample ? sample : std::make_shared<Sample>();
-	hdata->state = new Sample::PlaybackState(_n->hasDetuningInfo());
+	hdata->sample = sample ? sample : emptySample;
+	hdata->state.reset(_n->hasDetuningInfo());
 
 	_n->m_pluginData = hdata;
 }
@@ -26,6 +26,12 @@
 #ifndef PATMAN_H
 #define PATMAN_H
 
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <memory>
+#include <vector>
+
 #include "Instrument.h"
 #include "InstrumentView.h"
 #include "Sample.h"
@@ -84,18 +90,40 @@ public slots:
 
 
 private:
+	using PatchSamples = QVector<std::shared_ptr<Sample>>;
+
 	struct handle_data
 	{
-		Sample::PlaybackState* state;
-		bool tuned;
+		Sample::PlaybackState state;
+		bool tuned = true;
 		std::shared_ptr<Sample> sample;
+		//! Whether this belongs to m_voices, or was allocated because all of them were in use
+		bool pooled = true;
+	};
+
+	//! A decoded patch file, as long as any instrument uses it
+	struct CachedPatch
+	{
+		QDateTime lastModified;
+		qint64 size;
+		std::weak_ptr<const PatchSamples> samples;
 	};
 
 	QString m_patchFile;
-	QVector<std::shared_ptr<Sample>> m_patchSamples;
+	//! Shared with other instruments using the same patch file
+	std::shared_ptr<const PatchSamples> m_patchSamples;
 	BoolModel m_loopedModel;
 	BoolModel m_tunedModel;
 
+	static constexpr std::size_t VoicePoolSize = 64;
+	//! Playback states for the notes, allocated once so notes start without allocating
+	std::unique_ptr<handle_data[]> m_voices;
+	std::vector<handle_data*> m_freeVoices;
+	QMutex m_voicePoolMutex;
+
+	inline static QHash<QString, CachedPatch> s_patchCache;
+	inline static QMutex s_patchCacheMutex;
+
 
 	enum class LoadError
 	{
@@ -108,6 +136,7 @@ private:
 	} ;
 
 	LoadError loadPatch( const QString & _filename );
+	LoadError decodePatch( const QString & _filename, PatchSamples & _samples );
 	void unloadCurrentPatch();
 
 	void selectSample( NotePlayHandle * _n );
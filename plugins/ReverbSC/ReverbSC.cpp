@@ -23,6 +23,7 @@
 #include <cmath>
 #include "ReverbSC.h"
 
+#include "ValueSpan.h"
 #include "embed.h"
 #include "plugin_export.h"
 
@@ -89,29 +90,22 @@ bool ReverbSCEffect::processAudioBuffer( sampleFrame* buf, const fpp_t frames )
 	SPFLOAT tmpL, tmpR;
 	SPFLOAT dcblkL, dcblkR;
 
-	ValueBuffer * inGainBuf = m_reverbSCControls.m_inputGainModel.valueBuffer();
-	ValueBuffer * sizeBuf = m_reverbSCControls.m_sizeModel.valueBuffer();
-	ValueBuffer * colorBuf = m_reverbSCControls.m_colorModel.valueBuffer();
-	ValueBuffer * outGainBuf = m_reverbSCControls.m_outputGainModel.valueBuffer();
+	const auto inGainDb = ValueSpan{ m_reverbSCControls.m_inputGainModel };
+	const auto size = ValueSpan{ m_reverbSCControls.m_sizeModel };
+	const auto color = ValueSpan{ m_reverbSCControls.m_colorModel };
+	const auto outGainDb = ValueSpan{ m_reverbSCControls.m_outputGainModel };
 
 	for( fpp_t f = 0; f < frames; ++f )
 	{
 		auto s = std::array{buf[f][0], buf[f][1]};
 
-		const auto inGain
-			= (SPFLOAT)DB2LIN((inGainBuf ? inGainBuf->values()[f] : m_reverbSCControls.m_inputGainModel.value()));
-		const auto outGain
-			= (SPFLOAT)DB2LIN((outGainBuf ? outGainBuf->values()[f] : m_reverbSCControls.m_outputGainModel.value()));
+		const auto inGain = (SPFLOAT)DB2LIN(inGainDb[f]);
+		const auto outGain = (SPFLOAT)DB2LIN(outGainDb[f]);
 
 		s[0] *= inGain;
 		s[1] *= inGain;
-		revsc->feedback = (SPFLOAT)(sizeBuf ?
-			sizeBuf->values()[f]
-			: m_reverbSCControls.m_sizeModel.value());
-
-		revsc->lpfreq = (SPFLOAT)(colorBuf ?
-			colorBuf->values()[f]
-			: m_reverbSCControls.m_colorModel.value());
+		revsc->feedback = (SPFLOAT)size[f];
+		revsc->lpfreq = (SPFLOAT)color[f];
 
 
 		sp_revsc_compute(sp, revsc, &s[0], &s[1], &tmpL, &tmpR);
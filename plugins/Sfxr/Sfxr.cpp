@@ -35,6 +35,7 @@ float frnd(float range)
 	return (float)rnd(10000)/10000*range;
 }
 
+#include <algorithm>
 #include <cmath>
 
 #include <QDomElement>
@@ -80,6 +81,9 @@ Plugin::Descriptor PLUGIN_EXPORT sfxr_plugin_descriptor =
 
 SfxrSynth::SfxrSynth( const SfxrInstrument * s ):
 	s(s),
+	m_resampler( Engine::audioEngine()->currentQualitySettings().libsrcInterpolation(), DEFAULT_CHANNELS ),
+	m_pendingOffset( 0 ),
+	m_pendingFrames( 0 ),
 	playing_sample( true )
 {
     resetSample( false );
@@ -312,6 +316,42 @@ void SfxrSynth::update( sampleFrame * buffer, const int32_t frameNum )
 
 
 
+void SfxrSynth::updateResampled( sampleFrame * buffer, const fpp_t frameNum, double speed )
+{
+	// libsamplerate only supports ratios up to 256
+	speed = std::clamp( speed, 1.0 / 256, 256.0 );
+
+	fpp_t generated = 0;
+	while( generated < frameNum )
+	{
+		if( m_pendingFrames == 0 )
+		{
+			// The resampler may hold back some frames, so anything rendered
+			// but not used yet is kept for the next call
+			const auto needed = std::min( m_renderBuffer.size(),
+				static_cast<std::size_t>( std::ceil( ( frameNum - generated ) * speed ) ) + 1 );
+			update( m_renderBuffer.data(), needed );
+			m_pendingOffset = 0;
+			m_pendingFrames = needed;
+		}
+
+		const auto& input = m_renderBuffer[m_pendingOffset];
+		const auto result = m_resampler.resample( input.data(), m_pendingFrames,
+				buffer[generated].data(), frameNum - generated, 1.0 / speed );
+		if( result.error != 0 || ( result.inputFramesUsed == 0 && result.outputFramesGenerated == 0 ) )
+		{
+			std::fill( buffer + generated, buffer + frameNum, sampleFrame{} );
+			return;
+		}
+		m_pendingOffset += result.inputFramesUsed;
+		m_pendingFrames -= result.inputFramesUsed;
+		generated += result.outputFramesGenerated;
+	}
+}
+
+
+
+
 bool SfxrSynth::isPlaying() const
 {
 	return playing_sample;
@@ -459,25 +499,11 @@ void SfxrInstrument::playNote( NotePlayHandle * _n, sampleFrame * _working_buffe
 		return;
 	}
 
+	// The synth always runs at 44100 Hz, the pitch is changed by playing it back faster or slower
 	const auto baseFreq = instrumentTrack()->baseFreq();
-	int32_t pitchedFrameNum = (_n->frequency() / baseFreq) * frameNum;
-
-	pitchedFrameNum /= ( currentSampleRate / 44100 );
-
-// debug code
-//	qDebug( "pFN %d", pitchedFrameNum );
-
-	auto pitchedBuffer = new sampleFrame[pitchedFrameNum];
-	static_cast<SfxrSynth*>(_n->m_pluginData)->update( pitchedBuffer, pitchedFrameNum );
-	for( fpp_t i=0; i<frameNum; i++ )
-	{
-		for( ch_cnt_t j=0; j<DEFAULT_CHANNELS; j++ )
-		{
-			_working_buffer[i+offset][j] = pitchedBuffer[i*pitchedFrameNum/frameNum][j];
-		}
-	}
+	const double speed = ( _n->frequency() / baseFreq ) * ( 44100 / currentSampleRate );
 
-	delete[] pitchedBuffer;
+	static_cast<SfxrSynth*>(_n->m_pluginData)->updateResampled( _working_buffer + offset, frameNum, speed );
 
 	applyRelease( _working_buffer, _n );
 }
@@ -28,6 +28,9 @@
 #ifndef SFXR_H
 #define SFXR_H
 
+#include <array>
+
+#include "AudioResampler.h"
 #include "AutomatableModel.h"
 #include "Instrument.h"
 #include "InstrumentView.h"
@@ -83,11 +86,22 @@ public:
 
 	void resetSample( bool restart );
 	void update( sampleFrame * buffer, const int32_t frameNum );
+	//! Renders @p frameNum frames of the sound played back @p speed times as fast
+	void updateResampled( sampleFrame * buffer, const fpp_t frameNum, double speed );
 
 	bool isPlaying() const;
 
 private:
 	const SfxrInstrument * s;
+
+	//! Frames rendered at once before resampling, fast notes render several times per period
+	static constexpr std::size_t RenderBufferFrames = 256;
+
+	AudioResampler m_resampler;
+	//! Rendered frames, of which m_pendingFrames starting at m_pendingOffset have not been resampled yet
+	std::array<sampleFrame, RenderBufferFrames> m_renderBuffer;
+	std::size_t m_pendingOffset;
+	std::size_t m_pendingFrames;
 	bool playing_sample;
 	int phase;
 	double fperiod;
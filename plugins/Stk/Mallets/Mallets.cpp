@@ -125,6 +125,20 @@ MalletsInstrument::MalletsInstrument( InstrumentTrack * _instrument_track ):
 	m_scalers.append( 16.0 );
 	m_presetsModel.addItem( tr( "Tibetan bowl" ) );
 	m_scalers.append( 7.0 );
+
+	connect( &m_presetsModel, SIGNAL( dataChanged() ),
+			this, SLOT( fillVoicePool() ) );
+	connect( Engine::audioEngine(), SIGNAL( sampleRateChanged() ),
+			this, SLOT( fillVoicePool() ) );
+	fillVoicePool();
+}
+
+
+
+
+MalletsInstrument::~MalletsInstrument()
+{
+	clearVoicePool();
 }
 
 
@@ -328,12 +342,11 @@ void MalletsInstrument::playNote( NotePlayHandle * _n,
 			speed = std::clamp(speed, 0.0f, 128.0f);
 		}
 
-		// critical section as STK is not thread-safe
-		static QMutex m;
-		m.lock();
+		Instrmnt * voice = acquireVoice( voiceType( p ) );
 		if( p < 9 )
 		{
-			_n->m_pluginData = new MalletsSynth( freq,
+			_n->m_pluginData = new MalletsSynth( voice,
+						freq,
 						vel,
 						m_stickModel.value(),
 						hardness,
@@ -341,12 +354,12 @@ void MalletsInstrument::playNote( NotePlayHandle * _n,
 						m_vibratoGainModel.value(),
 						m_vibratoFreqModel.value(),
 						p,
-						(uint8_t) m_spreadModel.value(),
-				Engine::audioEngine()->outputSampleRate() );
+						(uint8_t) m_spreadModel.value() );
 		}
 		else if( p == 9 )
 		{
-			_n->m_pluginData = new MalletsSynth( freq,
+			_n->m_pluginData = new MalletsSynth( voice,
+						freq,
 						vel,
 						p,
 						m_lfoDepthModel.value(),
@@ -354,12 +367,12 @@ void MalletsInstrument::playNote( NotePlayHandle * _n,
 						crossfade,
 						m_lfoSpeedModel.value(),
 						m_adsrModel.value(),
-						(uint8_t) m_spreadModel.value(),
-				Engine::audioEngine()->outputSampleRate() );
+						(uint8_t) m_spreadModel.value() );
 		}
 		else
 		{
-			_n->m_pluginData = new MalletsSynth( freq,
+			_n->m_pluginData = new MalletsSynth( voice,
+						freq,
 						vel,
 						pressure,
 						m_motionModel.value(),
@@ -367,10 +380,8 @@ void MalletsInstrument::playNote( NotePlayHandle * _n,
 						p - 10,
 						m_strikeModel.value() * 128.0,
 						speed,
-						(uint8_t) m_spreadModel.value(),
-				Engine::audioEngine()->outputSampleRate() );
+						(uint8_t) m_spreadModel.value() );
 		}
-		m.unlock();
 		static_cast<MalletsSynth *>(_n->m_pluginData)->setPresetIndex(p);
 	}
 
@@ -413,7 +424,177 @@ void MalletsInstrument::playNote( NotePlayHandle * _n,
 
 void MalletsInstrument::deleteNotePluginData( NotePlayHandle * _n )
 {
-	delete static_cast<MalletsSynth *>( _n->m_pluginData );
+	auto ps = static_cast<MalletsSynth *>( _n->m_pluginData );
+	if( ps == nullptr )
+	{
+		return;
+	}
+	releaseVoice( voiceType( ps->presetIndex() ), ps->voice() );
+	delete ps;
+}
+
+
+
+
+MalletsInstrument::VoiceType MalletsInstrument::voiceType( int _preset )
+{
+	if( _preset < 9 )
+	{
+		return VoiceType::ModalBar;
+	}
+	return _preset == 9 ? VoiceType::TubeBell : VoiceType::BandedWG;
+}
+
+
+
+
+Instrmnt * MalletsInstrument::createVoice( VoiceType _type )
+{
+	// critical section as STK is not thread-safe
+	static QMutex m;
+	QMutexLocker locker( &m );
+
+	try
+	{
+		Stk::setSampleRate( Engine::audioEngine()->outputSampleRate() );
+		Stk::setRawwavePath( QDir( ConfigManager::inst()->stkDir() ).absolutePath()
+						.toLocal8Bit().constData() );
+#ifndef LMMS_DEBUG
+		Stk::showWarnings( false );
+#endif
+
+		switch( _type )
+		{
+			case VoiceType::ModalBar:
+				return new ModalBar();
+			case VoiceType::TubeBell:
+				return new TubeBell();
+			default:
+				return new BandedWG();
+		}
+	}
+	catch( ... )
+	{
+		return nullptr;
+	}
+}
+
+
+
+
+Instrmnt * MalletsInstrument::acquireVoice( VoiceType _type )
+{
+	{
+		QMutexLocker locker( &m_voicePoolMutex );
+		auto & pool = m_voicePool[static_cast<std::size_t>( _type )];
+		if( !pool.empty() )
+		{
+			Instrmnt * voice = pool.back();
+			pool.pop_back();
+			return voice;
+		}
+	}
+
+	return createVoice( _type );
+}
+
+
+
+
+void MalletsInstrument::releaseVoice( VoiceType _type, Instrmnt * _voice )
+{
+	if( _voice == nullptr )
+	{
+		return;
+	}
+
+	_voice->noteOff( 0.0 );
+	switch( _type )
+	{
+		case VoiceType::ModalBar:
+			static_cast<ModalBar *>( _voice )->clear();
+			break;
+		case VoiceType::BandedWG:
+			static_cast<BandedWG *>( _voice )->clear();
+			break;
+		default:
+			// FM voices have no clear(), the next noteOn() restarts their envelopes
+			break;
+	}
+
+	{
+		QMutexLocker locker( &m_voicePoolMutex );
+		auto & pool = m_voicePool[static_cast<std::size_t>( _type )];
+		if( m_voiceSampleRate == Engine::audioEngine()->outputSampleRate() &&
+			pool.size() < VoicePoolSize )
+		{
+			pool.push_back( _voice );
+			return;
+		}
+	}
+
+	delete _voice;
+}
+
+
+
+
+void MalletsInstrument::fillVoicePool()
+{
+	if( m_filesMissing )
+	{
+		return;
+	}
+
+	const auto type = voiceType( m_presetsModel.value() );
+	const auto sampleRate = Engine::audioEngine()->outputSampleRate();
+	auto & pool = m_voicePool[static_cast<std::size_t>( type )];
+
+	std::size_t missing = 0;
+	{
+		QMutexLocker locker( &m_voicePoolMutex );
+		if( sampleRate != m_voiceSampleRate )
+		{
+			// the voices have been set up for the old sample rate
+			for( auto & voices : m_voicePool )
+			{
+				for( auto voice : voices ) { delete voice; }
+				voices.clear();
+			}
+			m_voiceSampleRate = sampleRate;
+		}
+		missing = VoicePoolSize - pool.size();
+	}
+
+	// create the voices without holding the lock, as this reads from disk
+	std::vector<Instrmnt *> voices;
+	for( std::size_t i = 0; i < missing; ++i )
+	{
+		if( Instrmnt * voice = createVoice( type ) )
+		{
+			voices.push_back( voice );
+		}
+	}
+
+	QMutexLocker locker( &m_voicePoolMutex );
+	for( auto voice : voices )
+	{
+		if( pool.size() < VoicePoolSize ) { pool.push_back( voice ); }
+		else { delete voice; }
+	}
+}
+
+
+
+
+void MalletsInstrument::clearVoicePool()
+{
+	QMutexLocker locker( &m_voicePoolMutex );
+	for( auto & voices : m_voicePool )
+	{
+		for( auto voice : voices ) { delete voice; }
+		voices.clear();
+	}
 }
 
 
@@ -652,7 +833,8 @@ void MalletsInstrumentView::changePreset()
 
 
 // ModalBar
-MalletsSynth::MalletsSynth( const StkFloat _pitch,
+MalletsSynth::MalletsSynth( Instrmnt * _voice,
+				const StkFloat _pitch,
 				const StkFloat _velocity,
 				const StkFloat _control1,
 				const StkFloat _control2,
@@ -660,21 +842,12 @@ MalletsSynth::MalletsSynth( const StkFloat _pitch,
 				const StkFloat _control8,
 				const StkFloat _control11,
 				const int _control16,
-				const uint8_t _delay,
-				const sample_rate_t _sample_rate ) :
-	m_presetIndex(0)
+				const uint8_t _delay ) :
+	m_presetIndex(0),
+	m_voice( _voice )
 {
-	try
+	if( m_voice )
 	{
-		Stk::setSampleRate( _sample_rate );
-		Stk::setRawwavePath( QDir( ConfigManager::inst()->stkDir() ).absolutePath()
-						.toLocal8Bit().constData() );
-#ifndef LMMS_DEBUG
-		Stk::showWarnings( false );
-#endif
-
-		m_voice = new ModalBar();
-	
 		m_voice->controlChange( 16, _control16 );
 		m_voice->controlChange( 1, _control1 );
 		m_voice->controlChange( 2, _control2 );
@@ -685,10 +858,6 @@ MalletsSynth::MalletsSynth( const StkFloat _pitch,
 		
 		m_voice->noteOn( _pitch, _velocity );
 	}
-	catch( ... )
-	{
-		m_voice = nullptr;
-	}
 	
 	m_delay = new StkFloat[256];
 	m_delayRead = 0;
@@ -703,7 +872,8 @@ MalletsSynth::MalletsSynth( const StkFloat _pitch,
 
 
 // TubeBell
-MalletsSynth::MalletsSynth( const StkFloat _pitch,
+MalletsSynth::MalletsSynth( Instrmnt * _voice,
+				const StkFloat _pitch,
 				const StkFloat _velocity,
 				const int _preset,
 				const StkFloat _control1,
@@ -711,21 +881,12 @@ MalletsSynth::MalletsSynth( const StkFloat _pitch,
 				const StkFloat _control4,
 				const StkFloat _control11,
 				const StkFloat _control128,
-				const uint8_t _delay,
-				const sample_rate_t _sample_rate ) :
-	m_presetIndex(0)
+				const uint8_t _delay ) :
+	m_presetIndex(0),
+	m_voice( _voice )
 {
-	try
+	if( m_voice )
 	{
-		Stk::setSampleRate( _sample_rate );
-		Stk::setRawwavePath( QDir( ConfigManager::inst()->stkDir() ).absolutePath()
-						.toLocal8Bit().constData() );
-#ifndef LMMS_DEBUG
-		Stk::showWarnings( false );
-#endif
-
-		m_voice = new TubeBell();
-	
 		m_voice->controlChange( 1, _control1 );
 		m_voice->controlChange( 2, _control2 );
 		m_voice->controlChange( 4, _control4 );
@@ -734,10 +895,6 @@ MalletsSynth::MalletsSynth( const StkFloat _pitch,
 	
 		m_voice->noteOn( _pitch, _velocity );
 	}
-	catch( ... )
-	{
-		m_voice = nullptr;
-	}
 	
 	m_delay = new StkFloat[256];
 	m_delayRead = 0;
@@ -752,7 +909,8 @@ MalletsSynth::MalletsSynth( const StkFloat _pitch,
 
 
 // BandedWG
-MalletsSynth::MalletsSynth( const StkFloat _pitch,
+MalletsSynth::MalletsSynth( Instrmnt * _voice,
+				const StkFloat _pitch,
 				const StkFloat _velocity,
 				const StkFloat _control2,
 				const StkFloat _control4,
@@ -760,21 +918,12 @@ MalletsSynth::MalletsSynth( const StkFloat _pitch,
 				const int _control16,
 				const StkFloat _control64,
 				const StkFloat _control128,
-				const uint8_t _delay,
-				const sample_rate_t _sample_rate ) :
-	m_presetIndex(0)
+				const uint8_t _delay ) :
+	m_presetIndex(0),
+	m_voice( _voice )
 {
-	try
+	if( m_voice )
 	{
-		Stk::setSampleRate( _sample_rate );
-		Stk::setRawwavePath( QDir( ConfigManager::inst()->stkDir() ).absolutePath()
-						.toLocal8Bit().constData() );
-#ifndef LMMS_DEBUG
-		Stk::showWarnings( false );
-#endif
-
-		m_voice = new BandedWG();
-	
 		m_voice->controlChange( 1, 128.0 );
 		m_voice->controlChange( 2, _control2 );
 		m_voice->controlChange( 4, _control4 );
@@ -785,10 +934,6 @@ MalletsSynth::MalletsSynth( const StkFloat _pitch,
 	
 		m_voice->noteOn( _pitch, _velocity );
 	}
-	catch( ... )
-	{
-		m_voice = nullptr;
-	}
 	
 	m_delay = new StkFloat[256];
 	m_delayRead = 0;
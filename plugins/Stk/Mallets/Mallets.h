@@ -27,6 +27,11 @@
 #ifndef _MALLET_H
 #define _MALLET_H
 
+#include <array>
+#include <vector>
+
+#include <QMutex>
+
 #include <stk/Instrmnt.h>
 
 #include "ComboBox.h"
@@ -60,7 +65,8 @@ class MalletsSynth
 {
 public:
 	// ModalBar
-	MalletsSynth( const StkFloat _pitch,
+	MalletsSynth( Instrmnt * _voice,
+			const StkFloat _pitch,
 			const StkFloat _velocity,
 			const StkFloat _control1,
 			const StkFloat _control2,
@@ -68,11 +74,11 @@ public:
 			const StkFloat _control8,
 			const StkFloat _control11,
 			const int _control16,
-			const uint8_t _delay,
-			const sample_rate_t _sample_rate );
+			const uint8_t _delay );
 
 	// TubeBell
-	MalletsSynth( const StkFloat _pitch,
+	MalletsSynth( Instrmnt * _voice,
+			const StkFloat _pitch,
 			const StkFloat _velocity,
 			const int _preset,
 			const StkFloat _control1,
@@ -80,11 +86,11 @@ public:
 			const StkFloat _control4,
 			const StkFloat _control11,
 			const StkFloat _control128,
-			const uint8_t _delay,
-			const sample_rate_t _sample_rate );
+			const uint8_t _delay );
 
 	// BandedWG
-	MalletsSynth( const StkFloat _pitch,
+	MalletsSynth( Instrmnt * _voice,
+			const StkFloat _pitch,
 			const StkFloat _velocity,
 			const StkFloat _control2,
 			const StkFloat _control4,
@@ -92,14 +98,17 @@ public:
 			const int _control16,
 			const StkFloat _control64,
 			const StkFloat _control128,
-			const uint8_t _delay,
-			const sample_rate_t _sample_rate );
+			const uint8_t _delay );
 
+	//! The voice is owned by the instrument, which reuses it for later notes
 	inline ~MalletsSynth()
 	{
-		if (m_voice) {m_voice->noteOff(0.0);}
 		delete[] m_delay;
-		delete m_voice;
+	}
+
+	inline Instrmnt * voice() const
+	{
+		return m_voice;
 	}
 
 	inline sample_t nextSampleLeft()
@@ -186,7 +195,7 @@ class MalletsInstrument : public Instrument
 	Q_OBJECT
 public:
 	MalletsInstrument( InstrumentTrack * _instrument_track );
-	~MalletsInstrument() override = default;
+	~MalletsInstrument() override;
 
 	void playNote( NotePlayHandle * _n,
 						sampleFrame * _working_buffer ) override;
@@ -201,7 +210,27 @@ public:
 	gui::PluginView* instantiateView( QWidget * _parent ) override;
 
 
+private slots:
+	void fillVoicePool();
+	void clearVoicePool();
+
 private:
+	enum class VoiceType
+	{
+		ModalBar,
+		TubeBell,
+		BandedWG,
+		Count
+	};
+
+	static VoiceType voiceType( int _preset );
+	static Instrmnt * createVoice( VoiceType _type );
+
+	//! Takes a voice from the pool, only creating one if the pool is empty
+	Instrmnt * acquireVoice( VoiceType _type );
+	//! Silences and resets a voice of a finished note and puts it back into the pool
+	void releaseVoice( VoiceType _type, Instrmnt * _voice );
+
 	FloatModel m_hardnessModel;
 	FloatModel m_positionModel;
 	FloatModel m_vibratoGainModel;
@@ -231,6 +260,13 @@ private:
 
 	bool m_filesMissing;
 
+	// STK voices load their rawwave tables from disk when they are created,
+	// so they are created in advance and reused instead of being created on note-on
+	static constexpr std::size_t VoicePoolSize = 16;
+	std::array<std::vector<Instrmnt *>, static_cast<std::size_t>( VoiceType::Count )> m_voicePool;
+	QMutex m_voicePoolMutex;
+	sample_rate_t m_voiceSampleRate = 0;
+
 
 	friend class gui::MalletsInstrumentView;
 
@@ -122,6 +122,7 @@ struct ERect
 #include "Midi.h"
 #include "communication.h"
 #include "IoHelper.h"
+#include "denormals.h"
 
 #include "VstSyncData.h"
 
@@ -2213,6 +2214,8 @@ void * RemoteVstPlugin::processingThread(void * _param)
 
 	RemoteVstPlugin * _this = static_cast<RemoteVstPlugin *>( _param );
 
+	disable_denormals();
+
 	RemotePluginClient::message m;
 	while( ( m = _this->receiveMessage() ).id != IdQuit )
 	{
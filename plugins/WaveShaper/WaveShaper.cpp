@@ -28,12 +28,16 @@
 #include "lmms_math.h"
 #include "embed.h"
 #include "interpolation.h"
+#include "ValueSpan.h"
 
 #include "plugin_export.h"
 
 namespace lmms
 {
 
+// 2^2 = 4x oversampling to keep the shaper's harmonics from aliasing
+const int OS_STAGES = 2;
+
 
 extern "C"
 {
@@ -59,7 +63,10 @@ Plugin::Descriptor PLUGIN_EXPORT waveshaper_plugin_descriptor =
 WaveShaperEffect::WaveShaperEffect( Model * _parent,
 			const Descriptor::SubPluginFeatures::Key * _key ) :
 	Effect( &waveshaper_plugin_descriptor, _parent, _key ),
-	m_wsControls( this )
+	m_wsControls( this ),
+	m_oversampler( OS_STAGES, Engine::audioEngine()->framesPerPeriod() ),
+	m_shaped( Engine::audioEngine()->framesPerPeriod() ),
+	m_dry( Engine::audioEngine()->framesPerPeriod() )
 {
 }
 
@@ -80,27 +87,35 @@ bool WaveShaperEffect::processAudioBuffer( sampleFrame * _buf,
 	double out_sum = 0.0;
 	const float d = dryLevel();
 	const float w = wetLevel();
-	float input = m_wsControls.m_inputModel.value();
-	float output = m_wsControls.m_outputModel.value();
 	const float * samples = m_wsControls.m_wavegraphModel.samples();
 	const bool clip = m_wsControls.m_clipModel.value();
 
-	ValueBuffer *inputBuffer = m_wsControls.m_inputModel.valueBuffer();
-	ValueBuffer *outputBufer = m_wsControls.m_outputModel.valueBuffer();
+	const auto input = ValueSpan{ m_wsControls.m_inputModel };
+	const auto output = ValueSpan{ m_wsControls.m_outputModel };
 
-	int inputInc = inputBuffer ? 1 : 0;
-	int outputInc = outputBufer ? 1 : 0;
+	// the shaper runs on the oversampled signal, gains are taken from
+	// the value buffers at the original rate
+	sampleFrame * osBuf = m_oversampler.upsample( _buf, _frames );
 
-	const float *inputPtr = inputBuffer ? &( inputBuffer->values()[ 0 ] ) : &input;
-	const float *outputPtr = outputBufer ? &( outputBufer->values()[ 0 ] ) : &output;
+	// the dry signal gets the phase shift of the oversampling filters too, so
+	// mixing it with the shaped signal doesn't comb filter
+	const sampleFrame * dry = _buf;
+	if( d != 0.0f )
+	{
+		m_oversampler.downsampleDry( m_dry.data(), _frames );
+		dry = m_dry.data();
+	}
+	const int osStages = m_oversampler.stages();
+	const int osFrames = _frames << osStages;
 
-	for( fpp_t f = 0; f < _frames; ++f )
+	for( int f = 0; f < osFrames; ++f )
 	{
-		auto s = std::array{_buf[f][0], _buf[f][1]};
+		auto & s = osBuf[f];
+		const int base = f >> osStages;
 
 // apply input gain
-		s[0] *= *inputPtr;
-		s[1] *= *inputPtr;
+		s[0] *= input[base];
+		s[1] *= input[base];
 
 // clip if clip enabled
 		if( clip )
@@ -134,16 +149,18 @@ bool WaveShaperEffect::processAudioBuffer( sampleFrame * _buf,
 		}
 
 // apply output gain
-		s[0] *= *outputPtr;
-		s[1] *= *outputPtr;
+		s[0] *= output[base];
+		s[1] *= output[base];
+	}
 
+	m_oversampler.downsample( m_shaped.data(), _frames );
+
+	for( fpp_t f = 0; f < _frames; ++f )
+	{
 // mix wet/dry signals
-		_buf[f][0] = d * _buf[f][0] + w * s[0];
-		_buf[f][1] = d * _buf[f][1] + w * s[1];
+		_buf[f][0] = d * dry[f][0] + w * m_shaped[f][0];
+		_buf[f][1] = d * dry[f][1] + w * m_shaped[f][1];
 		out_sum += _buf[f][0] * _buf[f][0] + _buf[f][1] * _buf[f][1];
-
-		outputPtr += outputInc;
-		inputPtr += inputInc;
 	}
 
 	checkGate( out_sum / _frames );
@@ -27,7 +27,10 @@
 #ifndef _WAVESHAPER_H
 #define _WAVESHAPER_H
 
+#include <vector>
+
 #include "Effect.h"
+#include "Oversampler.h"
 #include "WaveShaperControls.h"
 
 namespace lmms
@@ -53,6 +56,10 @@ private:
 
 	WaveShaperControls m_wsControls;
 
+	Oversampler m_oversampler;
+	std::vector<sampleFrame> m_shaped;
+	std::vector<sampleFrame> m_dry;
+
 	friend class WaveShaperControls;
 
 } ;
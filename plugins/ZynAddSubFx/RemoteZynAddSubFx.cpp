@@ -36,6 +36,7 @@
 
 #include "RemotePluginClient.h"
 #include "LocalZynAddSubFx.h"
+#include "denormals.h"
 
 #include <Nio/Nio.h>
 #include <UI/MasterUI.h>
@@ -83,6 +84,8 @@ public:
 
 	void messageLoop()
 	{
+		disable_denormals();
+
 		message m;
 		while( ( m = receiveMessage() ).id != IdQuit )
 		{
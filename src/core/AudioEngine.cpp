@@ -37,6 +37,7 @@
 #include "NotePlayHandle.h"
 #include "ConfigManager.h"
 #include "SamplePlayHandle.h"
+#include "ThreadPolicy.h"
 
 // platform-specific audio-interface-classes
 #include "AudioAlsa.h"
@@ -1212,16 +1213,8 @@ void AudioEngine::fifoWriter::run()
 {
 	disable_denormals();
 
-#if 0
-#if defined(LMMS_BUILD_LINUX) || defined(LMMS_BUILD_FREEBSD)
-#ifdef LMMS_HAVE_SCHED_H
-	cpu_set_t mask;
-	CPU_ZERO( &mask );
-	CPU_SET( 0, &mask );
-	sched_setaffinity( 0, sizeof( mask ), &mask );
-#endif
-#endif
-#endif
+	// The worker threads take the CPUs before this one
+	ThreadPolicy::applyToCurrentThread(ThreadPolicy::Role::FifoWriter, m_audioEngine->m_numWorkers);
 
 	const fpp_t frames = m_audioEngine->framesPerPeriod();
 	while( m_writing )
@@ -31,6 +31,7 @@
 #include "denormals.h"
 #include "AudioEngine.h"
 #include "ThreadableJob.h"
+#include "ThreadPolicy.h"
 
 #if __SSE__
 #include <xmmintrin.h>
@@ -115,7 +116,8 @@ void AudioEngineWorkerThread::JobQueue::wait()
 
 AudioEngineWorkerThread::AudioEngineWorkerThread( AudioEngine* audioEngine ) :
 	QThread( audioEngine ),
-	m_quit( false )
+	m_quit( false ),
+	m_index( workerThreads.size() )
 {
 	// initialize global static data
 	if( queueReadyWaitCond == nullptr )
@@ -167,6 +169,7 @@ void AudioEngineWorkerThread::startAndWaitForJobs()
 void AudioEngineWorkerThread::run()
 {
 	disable_denormals();
+	ThreadPolicy::applyToCurrentThread(ThreadPolicy::Role::AudioWorker, m_index);
 
 	QMutex m;
 	while( m_quit == false )
@@ -66,4 +66,9 @@ void AudioResampler::setRatio(double ratio)
 	src_set_ratio(m_state, ratio);
 }
 
+void AudioResampler::reset()
+{
+	src_reset(m_state);
+}
+
 } // namespace lmms
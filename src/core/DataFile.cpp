@@ -307,6 +307,18 @@ void DataFile::write( QTextStream & _strm )
 
 
 
+QByteArray DataFile::serialize(bool compressed)
+{
+	QString xml;
+	QTextStream ts( &xml );
+	write( ts );
+	ts.flush();
+	return compressed ? qCompress( xml.toUtf8() ) : xml.toUtf8();
+}
+
+
+
+
 bool DataFile::writeFile(const QString& filename, bool withResources)
 {
 	// Small lambda function for displaying errors
@@ -399,10 +411,7 @@ bool DataFile::writeFile(const QString& filename, bool withResources)
 	const QString extension = fullName.section('.', -1);
 	if (extension == "mmpz" || extension == "xptz")
 	{
-		QString xml;
-		QTextStream ts( &xml );
-		write( ts );
-		outfile.write( qCompress( xml.toUtf8() ) );
+		outfile.write( serialize( true ) );
 	}
 	else
 	{
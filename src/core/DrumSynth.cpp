@@ -26,9 +26,13 @@
 #include "DrumSynth.h"
 
 #include <QFile>
+#include <algorithm>
+#include <array>
+#include <cctype>
 #include <cmath>
 #include <cstring>
-#include <sstream>
+
+#include "lmms_constants.h"
 
 #ifdef _MSC_VER
 // not #if LMMS_BUILD_WIN32 because we have strncasecmp in mingw
@@ -60,6 +64,47 @@ float phi[1200];
 long wavewords, wavemode = 0;
 float mem_t = 1.0f, mem_o = 1.0f, mem_n = 1.0f, mem_b = 1.0f, mem_tune = 1.0f, mem_time = 1.0f;
 
+namespace {
+
+constexpr int SineTableSize = 4096;
+
+// Same as sin(fmod(ph, TwoPi)), but using a table with linear interpolation
+float tableSin(float ph)
+{
+	static const auto table = []
+	{
+		auto values = std::array<float, SineTableSize + 1>{};
+		for (int i = 0; i <= SineTableSize; i++)
+		{
+			values[i] = static_cast<float>(std::sin(D_2PI * i / SineTableSize));
+		}
+		return values;
+	}();
+
+	const double pos = ph * (SineTableSize / static_cast<double>(TwoPi));
+	const double cell = std::floor(pos);
+	const auto index = static_cast<long long>(cell) & (SineTableSize - 1);
+	const auto frac = static_cast<float>(pos - cell);
+	return table[index] + frac * (table[index + 1] - table[index]);
+}
+
+// Keeps an incrementally advanced phase within [0, TwoPi) so it does not lose precision
+float wrapPhase(float ph)
+{
+	return ph - TwoPi * std::floor(ph / TwoPi);
+}
+
+std::string toLower(std::string str)
+{
+	for (auto& ch : str)
+	{
+		ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+	}
+	return str;
+}
+
+} // namespace
+
 int DrumSynth::LongestEnv()
 {
 	float l = 0.f;
@@ -122,11 +167,11 @@ void DrumSynth::UpdateEnv(int e, long t)
 	envData[e][PNT] = envData[e][PNT] + 1.0f;
 }
 
-void DrumSynth::GetEnv(int env, const char* sec, const char* key, QString ini)
+void DrumSynth::GetEnv(int env, const char* sec, const char* key)
 {
 	char en[256], s[8];
 	int i = 0, o = 0, ep = 0;
-	GetPrivateProfileString(sec, key, "0,0 100,0", en, sizeof(en), ini);
+	GetPrivateProfileString(sec, key, "0,0 100,0", en, sizeof(en));
 
 	// be safe!
 	en[255] = 0;
@@ -175,10 +220,10 @@ float DrumSynth::waveform(float ph, int form)
 	switch (form)
 	{
 	case 0:
-		w = static_cast<float>(sin(fmod(ph, TwoPi)));
+		w = tableSin(ph);
 		break; // sine
 	case 1:
-		w = static_cast<float>(fabs(2.0f * static_cast<float>(sin(fmod(0.5f * ph, TwoPi))) - 1.f));
+		w = static_cast<float>(fabs(2.0f * tableSin(0.5f * ph) - 1.f));
 		break; // sine^2
 	case 2:
 		while (ph < TwoPi)
@@ -196,100 +241,92 @@ float DrumSynth::waveform(float ph, int form)
 		w = (0.3183098f * w) - 1.f;
 		break;
 	default:
-		w = (sin(fmod(ph, TwoPi)) > 0.0) ? 1.f : -1.f;
+		w = (tableSin(ph) > 0.f) ? 1.f : -1.f;
 		break; // square
 	}
 
 	return w;
 }
 
-int DrumSynth::GetPrivateProfileString(
-	const char* sec, const char* key, const char* def, char* buffer, int size, QString file)
+bool DrumSynth::LoadProfile(const QString& file)
 {
-	stringstream is;
-	bool inSection = false;
-	int len = 0;
-
-	char* line = static_cast<char*>(malloc(200));
+	m_profile.clear();
 
 	// Use QFile to handle unicode file name on Windows
-	// Previously we used ifstream directly
 	QFile f(file);
-	f.open(QIODevice::ReadOnly);
-	QByteArray dat = f.readAll().constData();
-	is.str(string(dat.constData(), dat.size()));
+	if (!f.open(QIODevice::ReadOnly))
+	{
+		return false;
+	}
+	const QByteArray data = f.readAll();
 
-	while (is.good())
+	// Like the Windows API, only the first occurrence of a section or key counts
+	std::map<std::string, std::string>* section = nullptr;
+	for (const QByteArray& rawLine : data.split('\n'))
 	{
-		if (!inSection)
+		const std::string line = rawLine.toStdString();
+		const auto begin = line.find_first_not_of(" \t\r");
+		if (begin == std::string::npos)
 		{
-			is.ignore(numeric_limits<streamsize>::max(), '[');
+			continue;
+		}
 
-			if (!is.eof())
-			{
-				is.getline(line, 200, ']');
-				if (strcasecmp(line, sec) == 0)
-				{
-					inSection = true;
-				}
-			}
+		if (line[begin] == '[')
+		{
+			const auto end = line.find(']', begin);
+			const auto name = toLower(line.substr(begin + 1, end == std::string::npos ? end : end - begin - 1));
+			const auto [it, inserted] = m_profile.try_emplace(name);
+			section = inserted ? &it->second : nullptr;
+			continue;
 		}
-		else if (!is.eof())
+		if (section == nullptr)
 		{
-			is.getline(line, 200);
-			if (line[0] == '[')
-			{
-				break;
-			}
+			continue;
+		}
 
-			char* k = strtok(line, " \t=");
-			char* b = strtok(nullptr, "\n\r\0");
+		const auto keyBegin = line.find_first_not_of(" \t=");
+		if (keyBegin == std::string::npos)
+		{
+			continue;
+		}
+		const auto keyEnd = line.find_first_of(" \t=", keyBegin);
+		auto value = keyEnd == std::string::npos ? std::string{} : line.substr(keyEnd + 1);
+		value.erase(value.find_last_not_of(" \t\r") + 1);
+		section->try_emplace(toLower(line.substr(keyBegin, keyEnd - keyBegin)), std::move(value));
+	}
 
-			if (k != 0 && strcasecmp(k, key) == 0)
-			{
-				if (b == 0)
-				{
-					len = 0;
-					buffer[0] = 0;
-				}
-				else
-				{
-					k = static_cast<char*>(b + strlen(b) - 1);
-					while ((k >= b) && (*k == ' ' || *k == '\t'))
-					{
-						--k;
-					}
-					*(k + 1) = '\0';
+	return true;
+}
 
-					len = strlen(b);
-					if (len > size - 1)
-					{
-						len = size - 1;
-					}
-					strncpy(buffer, b, len + 1);
-				}
-				break;
-			}
+int DrumSynth::GetPrivateProfileString(const char* sec, const char* key, const char* def, char* buffer, int size)
+{
+	const std::string* value = nullptr;
+	if (const auto section = m_profile.find(toLower(sec)); section != m_profile.end())
+	{
+		if (const auto it = section->second.find(toLower(key)); it != section->second.end())
+		{
+			value = &it->second;
 		}
 	}
 
-	if (len == 0)
+	if (value == nullptr || value->empty())
 	{
-		len = strlen(def);
 		strncpy(buffer, def, size);
+		return strlen(def);
 	}
 
-	free(line);
-
+	const int len = std::min<int>(value->size(), size - 1);
+	memcpy(buffer, value->data(), len);
+	buffer[len] = 0;
 	return len;
 }
 
-int DrumSynth::GetPrivateProfileInt(const char* sec, const char* key, int def, QString file)
+int DrumSynth::GetPrivateProfileInt(const char* sec, const char* key, int def)
 {
 	char tmp[16];
 	int i = 0;
 
-	GetPrivateProfileString(sec, key, "", tmp, sizeof(tmp), file);
+	GetPrivateProfileString(sec, key, "", tmp, sizeof(tmp));
 	sscanf(tmp, "%d", &i);
 	if (tmp[0] == 0)
 	{
@@ -299,12 +336,12 @@ int DrumSynth::GetPrivateProfileInt(const char* sec, const char* key, int def, Q
 	return i;
 }
 
-float DrumSynth::GetPrivateProfileFloat(const char* sec, const char* key, float def, QString file)
+float DrumSynth::GetPrivateProfileFloat(const char* sec, const char* key, float def)
 {
 	char tmp[16];
 	float f = 0.f;
 
-	GetPrivateProfileString(sec, key, "", tmp, sizeof(tmp), file);
+	GetPrivateProfileString(sec, key, "", tmp, sizeof(tmp));
 	sscanf(tmp, "%f", &f);
 	if (tmp[0] == 0)
 	{
@@ -314,11 +351,6 @@ float DrumSynth::GetPrivateProfileFloat(const char* sec, const char* key, float
 	return f;
 }
 
-//  Constantly opening and scanning each file for the setting really sucks.
-//  But, the original did this, and we know it works.  Will store file into
-//  an associative array or something once we have a datastructure to load in to.
-//  llama
-
 int DrumSynth::GetDSFileSamples(QString dsfile, int16_t*& wave, int channels, sample_rate_t Fs)
 {
 	// input file
@@ -361,9 +393,15 @@ int DrumSynth::GetDSFileSamples(QString dsfile, int16_t*& wave, int channels, sa
 		mem_time = 1.0f;
 	}
 
+	// read all settings of the input file once
+	if (!LoadProfile(dsfile))
+	{
+		return 0;
+	}
+
 	// try to read version from input file
 	strcpy(sec, "General");
-	GetPrivateProfileString(sec, "Version", "", ver, sizeof(ver), dsfile);
+	GetPrivateProfileString(sec, "Version", "", ver, sizeof(ver));
 	ver[9] = 0;
 	if ((strcasecmp(ver, "DrumSynth") != 0) // input fail
 		|| (ver[11] != '1' && ver[11] != '2'))  // version fail
@@ -372,7 +410,7 @@ int DrumSynth::GetDSFileSamples(QString dsfile, int16_t*& wave, int channels, sa
 	}
 
 	// read master parameters
-	GetPrivateProfileString(sec, "Comment", "", comment, sizeof(comment), dsfile);
+	GetPrivateProfileString(sec, "Comment", "", comment, sizeof(comment));
 	while ((comment[commentLen] != 0) && (commentLen < 254))
 	{
 		commentLen++;
@@ -390,7 +428,7 @@ int DrumSynth::GetDSFileSamples(QString dsfile, int16_t*& wave, int channels, sa
 		commentLen++;
 	}
 
-	timestretch = .01f * mem_time * GetPrivateProfileFloat(sec, "Stretch", 100.0, dsfile);
+	timestretch = .01f * mem_time * GetPrivateProfileFloat(sec, "Stretch", 100.0);
 	if (timestretch < 0.2f)
 	{
 		timestretch = 0.2f;
@@ -403,23 +441,23 @@ int DrumSynth::GetDSFileSamples(QString dsfile, int16_t*& wave, int channels, sa
 	timestretch *= Fs / 44100.f;
 
 	DGain = 1.0f; // leave this here!
-	DGain = static_cast<float>(std::pow(10.0, 0.05 * GetPrivateProfileFloat(sec, "Level", 0, dsfile)));
+	DGain = static_cast<float>(std::pow(10.0, 0.05 * GetPrivateProfileFloat(sec, "Level", 0)));
 
-	MasterTune = GetPrivateProfileFloat(sec, "Tuning", 0.0, dsfile);
+	MasterTune = GetPrivateProfileFloat(sec, "Tuning", 0.0);
 	MasterTune = static_cast<float>(std::pow(1.0594631f, MasterTune + mem_tune));
-	MainFilter = 2 * GetPrivateProfileInt(sec, "Filter", 0, dsfile);
-	MFres = 0.0101f * GetPrivateProfileFloat(sec, "Resonance", 0.0, dsfile);
+	MainFilter = 2 * GetPrivateProfileInt(sec, "Filter", 0);
+	MFres = 0.0101f * GetPrivateProfileFloat(sec, "Resonance", 0.0);
 	MFres = static_cast<float>(std::pow(MFres, 0.5f));
 
-	HighPass = GetPrivateProfileInt(sec, "HighPass", 0, dsfile);
-	GetEnv(7, sec, "FilterEnv", dsfile);
+	HighPass = GetPrivateProfileInt(sec, "HighPass", 0);
+	GetEnv(7, sec, "FilterEnv");
 
 	// read noise parameters
 	strcpy(sec, "Noise");
-	chkOn[1] = GetPrivateProfileInt(sec, "On", 0, dsfile);
-	sliLev[1] = GetPrivateProfileInt(sec, "Level", 0, dsfile);
-	NT = GetPrivateProfileInt(sec, "Slope", 0, dsfile);
-	GetEnv(2, sec, "Envelope", dsfile);
+	chkOn[1] = GetPrivateProfileInt(sec, "On", 0);
+	sliLev[1] = GetPrivateProfileInt(sec, "Level", 0);
+	NT = GetPrivateProfileInt(sec, "Slope", 0);
+	GetEnv(2, sec, "Envelope");
 	NON = chkOn[1];
 	NL = static_cast<float>(sliLev[1] * sliLev[1]) * mem_n;
 	if (NT < 0)
@@ -441,18 +479,18 @@ int DrumSynth::GetDSFileSamples(QString dsfile, int16_t*& wave, int channels, sa
 
 	// read tone parameters
 	strcpy(sec, "Tone");
-	chkOn[0] = GetPrivateProfileInt(sec, "On", 0, dsfile);
+	chkOn[0] = GetPrivateProfileInt(sec, "On", 0);
 	TON = chkOn[0];
-	sliLev[0] = GetPrivateProfileInt(sec, "Level", 128, dsfile);
+	sliLev[0] = GetPrivateProfileInt(sec, "Level", 128);
 	TL = static_cast<float>(sliLev[0] * sliLev[0]) * mem_t;
-	GetEnv(1, sec, "Envelope", dsfile);
-	F1 = MasterTune * TwoPi * GetPrivateProfileFloat(sec, "F1", 200.0, dsfile) / Fs;
+	GetEnv(1, sec, "Envelope");
+	F1 = MasterTune * TwoPi * GetPrivateProfileFloat(sec, "F1", 200.0) / Fs;
 	if (fabs(F1) < 0.001f)
 	{
 		F1 = 0.001f; // to prevent overtone ratio div0
 	}
-	F2 = MasterTune * TwoPi * GetPrivateProfileFloat(sec, "F2", 120.0, dsfile) / Fs;
-	TDroopRate = GetPrivateProfileFloat(sec, "Droop", 0.f, dsfile);
+	F2 = MasterTune * TwoPi * GetPrivateProfileFloat(sec, "F2", 120.0) / Fs;
+	TDroopRate = GetPrivateProfileFloat(sec, "Droop", 0.f);
 	if (TDroopRate > 0.f)
 	{
 		TDroopRate = static_cast<float>(std::pow(10.0f, (TDroopRate - 20.0f) / 30.0f));
@@ -466,22 +504,22 @@ int DrumSynth::GetDSFileSamples(QString dsfile, int16_t*& wave, int channels, sa
 		ddF = F2 - F1;
 	}
 
-	Tphi = GetPrivateProfileFloat(sec, "Phase", 90.f, dsfile) / 57.29578f; // degrees>radians
+	Tphi = GetPrivateProfileFloat(sec, "Phase", 90.f) / 57.29578f; // degrees>radians
 
 	// read overtone parameters
 	strcpy(sec, "Overtones");
-	chkOn[2] = GetPrivateProfileInt(sec, "On", 0, dsfile);
+	chkOn[2] = GetPrivateProfileInt(sec, "On", 0);
 	OON = chkOn[2];
-	sliLev[2] = GetPrivateProfileInt(sec, "Level", 128, dsfile);
+	sliLev[2] = GetPrivateProfileInt(sec, "Level", 128);
 	OL = static_cast<float>(sliLev[2] * sliLev[2]) * mem_o;
-	GetEnv(3, sec, "Envelope1", dsfile);
-	GetEnv(4, sec, "Envelope2", dsfile);
-	OMode = GetPrivateProfileInt(sec, "Method", 2, dsfile);
-	OF1 = MasterTune * TwoPi * GetPrivateProfileFloat(sec, "F1", 200.0, dsfile) / Fs;
-	OF2 = MasterTune * TwoPi * GetPrivateProfileFloat(sec, "F2", 120.0, dsfile) / Fs;
-	OW1 = GetPrivateProfileInt(sec, "Wave1", 0, dsfile);
-	OW2 = GetPrivateProfileInt(sec, "Wave2", 0, dsfile);
-	OBal2 = static_cast<float>(GetPrivateProfileInt(sec, "Param", 50, dsfile));
+	GetEnv(3, sec, "Envelope1");
+	GetEnv(4, sec, "Envelope2");
+	OMode = GetPrivateProfileInt(sec, "Method", 2);
+	OF1 = MasterTune * TwoPi * GetPrivateProfileFloat(sec, "F1", 200.0) / Fs;
+	OF2 = MasterTune * TwoPi * GetPrivateProfileFloat(sec, "F2", 120.0) / Fs;
+	OW1 = GetPrivateProfileInt(sec, "Wave1", 0);
+	OW2 = GetPrivateProfileInt(sec, "Wave2", 0);
+	OBal2 = static_cast<float>(GetPrivateProfileInt(sec, "Param", 50));
 	ODrive = static_cast<float>(std::pow(OBal2, 3.0f)) / std::pow(50.0f, 3.0f);
 	OBal2 *= 0.01f;
 	OBal1 = 1.f - OBal2;
@@ -489,14 +527,14 @@ int DrumSynth::GetDSFileSamples(QString dsfile, int16_t*& wave, int channels, sa
 	Ophi2 = Tphi;
 	if (MainFilter == 0)
 	{
-		MainFilter = GetPrivateProfileInt(sec, "Filter", 0, dsfile);
+		MainFilter = GetPrivateProfileInt(sec, "Filter", 0);
 	}
-	if ((GetPrivateProfileInt(sec, "Track1", 0, dsfile) == 1) && (TON == 1))
+	if ((GetPrivateProfileInt(sec, "Track1", 0) == 1) && (TON == 1))
 	{
 		OF1Sync = 1;
 		OF1 = OF1 / F1;
 	}
-	if ((GetPrivateProfileInt(sec, "Track2", 0, dsfile) == 1) && (TON == 1))
+	if ((GetPrivateProfileInt(sec, "Track2", 0) == 1) && (TON == 1))
 	{
 		OF2Sync = 1;
 		OF2 = OF2 / F1;
@@ -515,36 +553,36 @@ int DrumSynth::GetDSFileSamples(QString dsfile, int16_t*& wave, int channels, sa
 
 	// read noise band parameters
 	strcpy(sec, "NoiseBand");
-	chkOn[3] = GetPrivateProfileInt(sec, "On", 0, dsfile);
+	chkOn[3] = GetPrivateProfileInt(sec, "On", 0);
 	BON = chkOn[3];
-	sliLev[3] = GetPrivateProfileInt(sec, "Level", 128, dsfile);
+	sliLev[3] = GetPrivateProfileInt(sec, "Level", 128);
 	BL = static_cast<float>(sliLev[3] * sliLev[3]) * mem_b;
-	BF = MasterTune * TwoPi * GetPrivateProfileFloat(sec, "F", 1000.0, dsfile) / Fs;
+	BF = MasterTune * TwoPi * GetPrivateProfileFloat(sec, "F", 1000.0) / Fs;
 	BPhi = TwoPi / 8.f;
-	GetEnv(5, sec, "Envelope", dsfile);
-	BFStep = GetPrivateProfileInt(sec, "dF", 50, dsfile);
+	GetEnv(5, sec, "Envelope");
+	BFStep = GetPrivateProfileInt(sec, "dF", 50);
 	BQ = static_cast<float>(BFStep);
 	BQ = BQ * BQ / (10000.f - 6600.f * (static_cast<float>(sqrt(BF)) - 0.19f));
 	BFStep = 1 + static_cast<int>((40.f - (BFStep / 2.5f)) / (BQ + 1.f + (1.f * BF)));
 
 	strcpy(sec, "NoiseBand2");
-	chkOn[4] = GetPrivateProfileInt(sec, "On", 0, dsfile);
+	chkOn[4] = GetPrivateProfileInt(sec, "On", 0);
 	BON2 = chkOn[4];
-	sliLev[4] = GetPrivateProfileInt(sec, "Level", 128, dsfile);
+	sliLev[4] = GetPrivateProfileInt(sec, "Level", 128);
 	BL2 = static_cast<float>(sliLev[4] * sliLev[4]) * mem_b;
-	BF2 = MasterTune * TwoPi * GetPrivateProfileFloat(sec, "F", 1000.0, dsfile) / Fs;
+	BF2 = MasterTune * TwoPi * GetPrivateProfileFloat(sec, "F", 1000.0) / Fs;
 	BPhi2 = TwoPi / 8.f;
-	GetEnv(6, sec, "Envelope", dsfile);
-	BFStep2 = GetPrivateProfileInt(sec, "dF", 50, dsfile);
+	GetEnv(6, sec, "Envelope");
+	BFStep2 = GetPrivateProfileInt(sec, "dF", 50);
 	BQ2 = static_cast<float>(BFStep2);
 	BQ2 = BQ2 * BQ2 / (10000.f - 6600.f * (static_cast<float>(sqrt(BF2)) - 0.19f));
 	BFStep2 = 1 + static_cast<int>((40 - (BFStep2 / 2.5)) / (BQ2 + 1 + (1 * BF2)));
 
 	// read distortion parameters
 	strcpy(sec, "Distortion");
-	chkOn[5] = GetPrivateProfileInt(sec, "On", 0, dsfile);
+	chkOn[5] = GetPrivateProfileInt(sec, "On", 0);
 	DiON = chkOn[5];
-	DStep = 1 + GetPrivateProfileInt(sec, "Rate", 0, dsfile);
+	DStep = 1 + GetPrivateProfileInt(sec, "Rate", 0);
 	if (DStep == 7) { DStep = 20; }
 	if (DStep == 6) { DStep = 10; }
 	if (DStep == 5) { DStep = 8; }
@@ -556,9 +594,9 @@ int DrumSynth::GetDSFileSamples(QString dsfile, int16_t*& wave, int channels, sa
 	{
 		DAtten = DGain * static_cast<short>(LoudestEnv());
 		clippoint = DAtten > 32700 ? 32700 : static_cast<short>(DAtten);
-		DAtten = static_cast<float>(std::pow(2.0, 2.0 * GetPrivateProfileInt(sec, "Bits", 0, dsfile)));
+		DAtten = static_cast<float>(std::pow(2.0, 2.0 * GetPrivateProfileInt(sec, "Bits", 0)));
 		DGain = DAtten * DGain
-			* static_cast<float>(std::pow(10.0, 0.05 * GetPrivateProfileInt(sec, "Clipping", 0, dsfile)));
+			* static_cast<float>(std::pow(10.0, 0.05 * GetPrivateProfileInt(sec, "Clipping", 0)));
 	}
 
 	// prepare envelopes
@@ -656,9 +694,13 @@ int DrumSynth::GetDSFileSamples(QString dsfile, int16_t*& wave, int channels, sa
 			TphiStart = Tphi;
 			if (TDroop == 1)
 			{
+				// exp(t * TDroopRate), advanced by multiplication within the block
+				const float droopStep = static_cast<float>(exp(TDroopRate));
+				float droop = static_cast<float>(exp(tpos * TDroopRate));
 				for (t = tpos; t <= tplus; t++)
 				{
-					phi[t - tpos] = F2 + (ddF * static_cast<float>(exp(t * TDroopRate)));
+					phi[t - tpos] = F2 + (ddF * droop);
+					droop *= droopStep;
 				}
 			}
 			else
@@ -680,7 +722,7 @@ int DrumSynth::GetDSFileSamples(QString dsfile, int16_t*& wave, int channels, sa
 					UpdateEnv(1, t);
 				}
 				Tphi = Tphi + phi[totmp];
-				DF[totmp] += TL * envData[1][ENV] * static_cast<float>(sin(fmod(Tphi, TwoPi))); // overflow?
+				DF[totmp] += TL * envData[1][ENV] * tableSin(Tphi); // overflow?
 			}
 			if (t >= envData[1][MAX])
 			{
@@ -711,9 +753,9 @@ int DrumSynth::GetDSFileSamples(QString dsfile, int16_t*& wave, int channels, sa
 				{
 					BdF = randmax * static_cast<float>(rand()) - 0.5f;
 				}
-				BPhi = BPhi + BF + BQ * BdF;
+				BPhi = wrapPhase(BPhi + BF + BQ * BdF);
 				botmp = t - tpos;
-				DF[botmp] = DF[botmp] + static_cast<float>(cos(fmod(BPhi, TwoPi))) * envData[5][ENV] * BL;
+				DF[botmp] = DF[botmp] + tableSin(BPhi + 0.25f * TwoPi) * envData[5][ENV] * BL;
 			}
 			if (t >= envData[5][MAX])
 			{
@@ -737,9 +779,9 @@ int DrumSynth::GetDSFileSamples(QString dsfile, int16_t*& wave, int channels, sa
 				{
 					BdF2 = randmax * static_cast<float>(rand()) - 0.5f;
 				}
-				BPhi2 = BPhi2 + BF2 + BQ2 * BdF2;
+				BPhi2 = wrapPhase(BPhi2 + BF2 + BQ2 * BdF2);
 				botmp = t - tpos;
-				DF[botmp] = DF[botmp] + static_cast<float>(cos(fmod(BPhi2, TwoPi))) * envData[6][ENV] * BL2;
+				DF[botmp] = DF[botmp] + tableSin(BPhi2 + 0.25f * TwoPi) * envData[6][ENV] * BL2;
 			}
 			if (t >= envData[6][MAX])
 			{
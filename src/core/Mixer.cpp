@@ -62,8 +62,6 @@ MixerChannel::MixerChannel( int idx, Model * _parent ) :
 	m_fxChain( nullptr ),
 	m_hasInput( false ),
 	m_stillRunning( false ),
-	m_peakLeft( 0.0f ),
-	m_peakRight( 0.0f ),
 	m_buffer( new sampleFrame[Engine::audioEngine()->framesPerPeriod()] ),
 	m_muteModel( false, _parent ),
 	m_soloModel( false, _parent ),
@@ -72,7 +70,9 @@ MixerChannel::MixerChannel( int idx, Model * _parent ) :
 	m_lock(),
 	m_channelIndex( idx ),
 	m_queued( false ),
-	m_dependenciesMet(0)
+	m_dependenciesMet(0),
+	m_peakLeft(0.f),
+	m_peakRight(0.f)
 {
 	BufferManager::clear( m_buffer, Engine::audioEngine()->framesPerPeriod() );
 }
@@ -113,6 +113,19 @@ void MixerChannel::unmuteForSolo()
 	m_muteModel.setValue(false);
 }
 
+void MixerChannel::updatePeaks(float left, float right)
+{
+	// The GUI may reset the peaks at any time, so only raise them if they are
+	// still below the new value
+	const auto raise = [](std::atomic<float>& peak, float value)
+	{
+		float current = peak.load(std::memory_order_relaxed);
+		while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+	};
+	raise(m_peakLeft, left);
+	raise(m_peakRight, right);
+}
+
 
 
 void MixerChannel::doProcessing()
@@ -172,12 +185,11 @@ void MixerChannel::doProcessing()
 		m_stillRunning = m_fxChain.processAudioBuffer( m_buffer, fpp, m_hasInput );
 
 		AudioEngine::StereoSample peakSamples = Engine::audioEngine()->getPeakValues(m_buffer, fpp);
-		m_peakLeft = std::max(m_peakLeft, peakSamples.left * v);
-		m_peakRight = std::max(m_peakRight, peakSamples.right * v);
+		updatePeaks(peakSamples.left * v, peakSamples.right * v);
 	}
 	else
 	{
-		m_peakLeft = m_peakRight = 0.0f;
+		updatePeaks(0.f, 0.f);
 	}
 
 	// increment dependency counter of all receivers
@@ -36,7 +36,8 @@ namespace lmms
 
 PatternStore::PatternStore() :
 	TrackContainer(),
-	m_patternComboBoxModel(this)
+	m_patternComboBoxModel(this),
+	m_playbackInfoDirty(true)
 {
 	connect(&m_patternComboBoxModel, SIGNAL(dataChanged()),
 			this, SLOT(currentPatternChanged()));
@@ -44,6 +45,7 @@ PatternStore::PatternStore() :
 	// not change upon setCurrentPattern()-call
 	connect(&m_patternComboBoxModel, SIGNAL(dataUnchanged()),
 			this, SLOT(currentPatternChanged()));
+	connect(this, &TrackContainer::trackAdded, this, &PatternStore::connectTrack, Qt::DirectConnection);
 	setType(Type::Pattern);
 }
 
@@ -54,15 +56,15 @@ bool PatternStore::play(TimePos start, fpp_t frames, f_cnt_t offset, int clipNum
 {
 	bool notePlayed = false;
 
-	if (lengthOfPattern(clipNum) <= 0)
+	const PatternPlaybackInfo* info = playbackInfo(clipNum);
+	if (info == nullptr || info->length <= 0)
 	{
 		return false;
 	}
 
-	start = start % (lengthOfPattern(clipNum) * TimePos::ticksPerBar());
+	start = start % (info->length * TimePos::ticksPerBar());
 
-	const TrackList& tl = tracks();
-	for (Track * t : tl)
+	for (Track * t : info->tracks)
 	{
 		if (t->play(start, frames, offset, clipNum))
 		{
@@ -107,6 +109,15 @@ bar_t PatternStore::lengthOfPattern(int pattern) const
 
 
 
+bar_t PatternStore::playbackLengthOfPattern(int pattern) const
+{
+	const PatternPlaybackInfo* info = playbackInfo(pattern);
+	return info != nullptr ? info->length : lengthOfPattern(pattern);
+}
+
+
+
+
 int PatternStore::numOfPatterns() const
 {
 	return Engine::getSong()->countTracks(Track::Type::Pattern);
@@ -242,7 +253,7 @@ AutomatedValueMap PatternStore::automatedValuesAt(TimePos time, int clipNum) con
 	Q_ASSERT(clipNum >= 0);
 	Q_ASSERT(time.getTicks() >= 0);
 
-	auto lengthBars = lengthOfPattern(clipNum);
+	auto lengthBars = playbackLengthOfPattern(clipNum);
 	auto lengthTicks = lengthBars * TimePos::ticksPerBar();
 	if (time > lengthTicks)
 	{
@@ -253,4 +264,79 @@ AutomatedValueMap PatternStore::automatedValuesAt(TimePos time, int clipNum) con
 }
 
 
+
+
+void PatternStore::connectTrack(Track* track)
+{
+	connect(track, &Track::clipAdded, this, &PatternStore::connectClip, Qt::DirectConnection);
+	connect(track, &Track::destroyedTrack, this, &PatternStore::invalidatePlaybackInfo, Qt::DirectConnection);
+	for (Clip* clip : track->getClips())
+	{
+		connectClip(clip);
+	}
+	invalidatePlaybackInfo();
+}
+
+
+
+
+void PatternStore::connectClip(Clip* clip)
+{
+	// Lengths change with the clip, and with the notes of MIDI clips, which
+	// emit dataChanged()
+	connect(clip, &Clip::lengthChanged, this, &PatternStore::invalidatePlaybackInfo, Qt::DirectConnection);
+	connect(clip, &Clip::positionChanged, this, &PatternStore::invalidatePlaybackInfo, Qt::DirectConnection);
+	connect(clip, &Clip::destroyedClip, this, &PatternStore::invalidatePlaybackInfo, Qt::DirectConnection);
+	connect(clip, &Model::dataChanged, this, &PatternStore::invalidatePlaybackInfo, Qt::DirectConnection);
+	invalidatePlaybackInfo();
+}
+
+
+
+
+void PatternStore::invalidatePlaybackInfo()
+{
+	m_playbackInfoDirty = true;
+}
+
+
+
+
+const PatternStore::PatternPlaybackInfo* PatternStore::playbackInfo(int pattern) const
+{
+	if (m_playbackInfoDirty.exchange(false))
+	{
+		const TrackList& tl = tracks();
+		int patterns = 0;
+		for (Track * t : tl)
+		{
+			patterns = std::max(patterns, t->numOfClips());
+		}
+
+		m_playbackInfo.resize(patterns);
+		for (int i = 0; i < patterns; ++i)
+		{
+			PatternPlaybackInfo& info = m_playbackInfo[i];
+			info.length = lengthOfPattern(i);
+			info.tracks.clear();
+			for (Track * t : tl)
+			{
+				// Tracks with an empty clip still have to play, e.g. instrument
+				// tracks update their sounding notes and piano roll recording
+				if (i < t->numOfClips())
+				{
+					info.tracks.push_back(t);
+				}
+			}
+		}
+	}
+
+	if (pattern < 0 || pattern >= static_cast<int>(m_playbackInfo.size()))
+	{
+		return nullptr;
+	}
+	return &m_playbackInfo[pattern];
+}
+
+
 } // namespace lmms
\ No newline at end of file
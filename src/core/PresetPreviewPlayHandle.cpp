@@ -22,9 +22,15 @@
  *
  */
 
+#include "PresetPreviewPlayHandle.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include <QDateTime>
 #include <QFileInfo>
 
-#include "PresetPreviewPlayHandle.h"
 #include "AudioEngine.h"
 #include "Engine.h"
 #include "Instrument.h"
@@ -33,8 +39,6 @@
 #include "ProjectJournal.h"
 #include "TrackContainer.h"
 
-#include <atomic>
-
 namespace lmms
 {
 
@@ -42,15 +46,20 @@ namespace lmms
 class PreviewTrackContainer : public TrackContainer
 {
 public:
+	//! Number of preview instruments kept loaded, so that previewing one of
+	//! their presets again starts immediately. Instruments rendering a stream
+	//! (e.g. ZynAddSubFX, SF2) are never cached, as they keep running while
+	//! they are loaded.
+	static constexpr std::size_t CacheSize = 4;
+
 	PreviewTrackContainer() :
 		m_previewInstrumentTrack( nullptr ),
 		m_previewNote( nullptr ),
 		m_dataMutex()
 	{
 		setJournalling( false );
-		m_previewInstrumentTrack = dynamic_cast<InstrumentTrack *>( Track::create( Track::Type::Instrument, this ) );
-		m_previewInstrumentTrack->setJournalling( false );
-		m_previewInstrumentTrack->setPreviewMode( true );
+		m_cache.push_back( { createPreviewTrack(), QString() } );
+		m_previewInstrumentTrack = m_cache.front().track;
 	}
 
 	~PreviewTrackContainer() override = default;
@@ -62,7 +71,57 @@ public:
 
 	InstrumentTrack* previewInstrumentTrack()
 	{
-		return m_previewInstrumentTrack;
+		return m_previewInstrumentTrack.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * Makes the track previewing the preset identified by @p key the current
+	 * one. If no track has loaded this preset yet, the least recently used
+	 * track is reused, or a new one is created as long as the cache is not full.
+	 * @return whether the preset is already loaded into the track
+	 */
+	bool selectPreviewTrack( const QString & key )
+	{
+		auto it = std::find_if( m_cache.begin(), m_cache.end(),
+			[&key]( const CachedPreview & entry ) { return entry.key == key; } );
+		const bool loaded = it != m_cache.end();
+
+		if( !loaded )
+		{
+			if( m_cache.size() < CacheSize )
+			{
+				m_cache.push_back( { createPreviewTrack(), QString() } );
+			}
+			it = m_cache.end() - 1;
+			it->key = key;
+		}
+
+		// keep the most recently used track in front
+		std::rotate( m_cache.begin(), it, it + 1 );
+		m_previewInstrumentTrack.store( m_cache.front().track, std::memory_order_release );
+
+		// only the current track may keep a single streamed instrument
+		for( auto entry = m_cache.begin() + 1; entry != m_cache.end(); )
+		{
+			const Instrument * instrument = entry->track->instrument();
+			if( instrument != nullptr && instrument->isSingleStreamed() )
+			{
+				delete entry->track;
+				entry = m_cache.erase( entry );
+			}
+			else
+			{
+				++entry;
+			}
+		}
+
+		return loaded;
+	}
+
+	//! Makes the current track load its preset again the next time
+	void forgetCurrentPreset()
+	{
+		m_cache.front().key.clear();
 	}
 
 	NotePlayHandle* previewNote()
@@ -102,7 +161,23 @@ public:
 
 
 private:
-	InstrumentTrack* m_previewInstrumentTrack;
+	struct CachedPreview
+	{
+		InstrumentTrack* track;
+		QString key; //!< identifies the loaded preset, empty if none
+	};
+
+	InstrumentTrack* createPreviewTrack()
+	{
+		auto track = dynamic_cast<InstrumentTrack *>( Track::create( Track::Type::Instrument, this ) );
+		track->setJournalling( false );
+		track->setPreviewMode( true );
+		return track;
+	}
+
+	//! most recently used first
+	std::vector<CachedPreview> m_cache;
+	std::atomic<InstrumentTrack*> m_previewInstrumentTrack;
 	std::atomic<NotePlayHandle*> m_previewNote;
 	QMutex m_dataMutex;
 
@@ -117,6 +192,7 @@ PreviewTrackContainer * PresetPreviewPlayHandle::s_previewTC;
 
 PresetPreviewPlayHandle::PresetPreviewPlayHandle( const QString & _preset_file, bool _load_by_plugin, DataFile *dataFile ) :
 	PlayHandle( Type::PresetPreviewHandle ),
+	m_previewTrack(nullptr),
 	m_previewNote(nullptr)
 {
 	setUsesBuffer( false );
@@ -131,54 +207,69 @@ PresetPreviewPlayHandle::PresetPreviewPlayHandle( const QString & _preset_file,
 	const bool j = Engine::projectJournal()->isJournalling();
 	Engine::projectJournal()->setJournalling( false );
 
-	if( _load_by_plugin )
+	// identify the preset by file and modification time, so that edited
+	// presets are loaded again
+	const QFileInfo presetInfo( _preset_file );
+	const QString key = QString( "%1:%2:%3" ).arg(
+		presetInfo.absoluteFilePath(),
+		QString::number( presetInfo.lastModified().toMSecsSinceEpoch() ),
+		QString::number( _load_by_plugin ) );
+	const bool loaded = s_previewTC->selectPreviewTrack( key );
+	m_previewTrack = s_previewTC->previewInstrumentTrack();
+
+	// a cached instrument still holds the preset from its last preview
+	if( !loaded )
 	{
-		Instrument * i = s_previewTC->previewInstrumentTrack()->instrument();
-		const QString ext = QFileInfo( _preset_file ).
-							suffix().toLower();
-		if( i == nullptr || !i->descriptor()->supportsFileType( ext ) )
+		if( _load_by_plugin )
 		{
-			const PluginFactory::PluginInfoAndKey& infoAndKey =
-				getPluginFactory()->pluginSupportingExtension(ext);
-			i = s_previewTC->previewInstrumentTrack()->
-				loadInstrument(infoAndKey.info.name(), &infoAndKey.key);
+			Instrument * i = m_previewTrack->instrument();
+			const QString ext = presetInfo.suffix().toLower();
+			if( i == nullptr || !i->descriptor()->supportsFileType( ext ) )
+			{
+				const PluginFactory::PluginInfoAndKey& infoAndKey =
+					getPluginFactory()->pluginSupportingExtension(ext);
+				i = m_previewTrack->loadInstrument(infoAndKey.info.name(), &infoAndKey.key);
+			}
+			if( i != nullptr )
+			{
+				i->loadFile( _preset_file );
+			}
+			else
+			{
+				s_previewTC->forgetCurrentPreset();
+			}
 		}
-		if( i != nullptr )
-		{
-			i->loadFile( _preset_file );
-		}
-	}
-	else
-	{
-		bool dataFileCreated = false;
-		if( dataFile == 0 )
-		{
-			dataFile = new DataFile( _preset_file );
-			dataFileCreated = true;
-		}
-
-		s_previewTC->previewInstrumentTrack()->loadTrackSpecificSettings(
-					dataFile->content().firstChild().toElement());
-
-		if( dataFileCreated )
+		else
 		{
-			delete dataFile;
+			bool dataFileCreated = false;
+			if( dataFile == 0 )
+			{
+				dataFile = new DataFile( _preset_file );
+				dataFileCreated = true;
+			}
+
+			m_previewTrack->loadTrackSpecificSettings(
+						dataFile->content().firstChild().toElement());
+
+			if( dataFileCreated )
+			{
+				delete dataFile;
+			}
 		}
 	}
 	dataFile = 0;
 	// make sure, our preset-preview-track does not appear in any MIDI-
 	// devices list, so just disable receiving/sending MIDI-events at all
-	s_previewTC->previewInstrumentTrack()->
-				midiPort()->setMode( MidiPort::Mode::Disabled );
+	m_previewTrack->midiPort()->setMode( MidiPort::Mode::Disabled );
 
 	Engine::audioEngine()->requestChangeInModel();
 	// create note-play-handle for it
 	m_previewNote = NotePlayHandleManager::acquire(
-			s_previewTC->previewInstrumentTrack(), 0,
+			m_previewTrack, 0,
 			typeInfo<f_cnt_t>::max() / 2,
 				Note( 0, 0, DefaultKey, 100 ) );
 
-	setAudioPort( s_previewTC->previewInstrumentTrack()->audioPort() );
+	setAudioPort( m_previewTrack->audioPort() );
 
 	s_previewTC->setPreviewNote( m_previewNote );
 
@@ -225,7 +316,7 @@ bool PresetPreviewPlayHandle::isFinished() const
 
 bool PresetPreviewPlayHandle::isFromTrack( const Track * _track ) const
 {
-	return s_previewTC && s_previewTC->previewInstrumentTrack() == _track;
+	return m_previewTrack == _track;
 }
 
 
@@ -28,6 +28,8 @@
 #include "ProjectRenderer.h"
 #include "Song.h"
 #include "PerfLog.h"
+#include "denormals.h"
+#include "ThreadPolicy.h"
 
 #include "AudioFileWave.h"
 #include "AudioFileOgg.h"
@@ -159,16 +161,8 @@ void ProjectRenderer::startProcessing()
 
 void ProjectRenderer::run()
 {
-#if 0
-#if defined(LMMS_BUILD_LINUX) || defined(LMMS_BUILD_FREEBSD)
-#ifdef LMMS_HAVE_SCHED_H
-	cpu_set_t mask;
-	CPU_ZERO( &mask );
-	CPU_SET( 0, &mask );
-	sched_setaffinity( 0, sizeof( mask ), &mask );
-#endif
-#endif
-#endif
+	disable_denormals();
+	ThreadPolicy::applyToCurrentThread(ThreadPolicy::Role::Encoder);
 
 	PerfLogTimer perfLog("Project Render");
 
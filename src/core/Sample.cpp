@@ -24,7 +24,9 @@
 
 #include "Sample.h"
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
 
 namespace lmms {
 
@@ -172,40 +174,61 @@ void Sample::setAllPointFrames(int startFrame, int endFrame, int loopStartFrame,
 
 void Sample::playRaw(sampleFrame* dst, size_t numFrames, const PlaybackState* state, Loop loopMode) const
 {
-	if (m_buffer->size() < 1) { return; }
+	const auto bufferSize = static_cast<int>(m_buffer->size());
+	if (bufferSize < 1) { return; }
+
+	const auto data = m_buffer->data();
+	const auto endFrame = m_endFrame.load(std::memory_order_relaxed);
+	const auto loopStartFrame = m_loopStartFrame.load(std::memory_order_relaxed);
+	const auto loopEndFrame = m_loopEndFrame.load(std::memory_order_relaxed);
+	const auto reversed = m_reversed.load(std::memory_order_relaxed);
 
 	auto index = state->m_frameIndex;
 	auto backwards = state->m_backwards;
 
-	for (size_t i = 0; i < numFrames; ++i)
+	// Copy contiguous runs of frames between the boundaries of the loop mode,
+	// applying the same boundary checks as frame by frame playback would
+	// at the start of each run
+	size_t framesCopied = 0;
+	while (framesCopied < numFrames)
 	{
+		auto runLength = static_cast<int>(std::min<size_t>(numFrames - framesCopied, std::numeric_limits<int>::max()));
+
 		switch (loopMode)
 		{
 		case Loop::Off:
-			if (index < 0 || index >= m_endFrame) { return; }
+			if (index < 0 || index >= endFrame) { return; }
+			runLength = std::min(runLength, backwards ? index + 1 : endFrame - index);
 			break;
 		case Loop::On:
-			if (index < m_loopStartFrame && backwards) { index = m_loopEndFrame - 1; }
-			else if (index >= m_loopEndFrame) { index = m_loopStartFrame; }
+			if (index < loopStartFrame && backwards) { index = loopEndFrame - 1; }
+			else if (index >= loopEndFrame) { index = loopStartFrame; }
+			runLength = std::min(runLength, std::max(1, backwards ? index - loopStartFrame + 1 : loopEndFrame - index));
 			break;
 		case Loop::PingPong:
-			if (index < m_loopStartFrame && backwards)
+			if (index < loopStartFrame && backwards)
 			{
-				index = m_loopStartFrame;
+				index = loopStartFrame;
 				backwards = false;
 			}
-			else if (index >= m_loopEndFrame)
+			else if (index >= loopEndFrame)
 			{
-				index = m_loopEndFrame - 1;
+				index = loopEndFrame - 1;
 				backwards = true;
 			}
+			runLength = std::min(runLength, std::max(1, backwards ? index - loopStartFrame + 1 : loopEndFrame - index));
 			break;
 		default:
 			break;
 		}
 
-		dst[i] = m_buffer->data()[m_reversed ? m_buffer->size() - index - 1 : index];
-		backwards ? --index : ++index;
+		// Reading a reversed sample backwards walks the buffer forwards
+		const auto first = reversed ? bufferSize - index - 1 : index;
+		if (backwards == reversed) { std::copy_n(data + first, runLength, dst + framesCopied); }
+		else { std::reverse_copy(data + first - runLength + 1, data + first + 1, dst + framesCopied); }
+
+		framesCopied += runLength;
+		index += backwards ? -runLength : runLength;
 	}
 }
 
@@ -214,32 +237,35 @@ void Sample::advance(PlaybackState* state, size_t advanceAmount, Loop loopMode)
 	state->m_frameIndex += (state->m_backwards ? -1 : 1) * advanceAmount;
 	if (loopMode == Loop::Off) { return; }
 
-	const auto distanceFromLoopStart = std::abs(state->m_frameIndex - m_loopStartFrame);
-	const auto distanceFromLoopEnd = std::abs(state->m_frameIndex - m_loopEndFrame);
-	const auto loopSize = m_loopEndFrame - m_loopStartFrame;
+	const auto loopStartFrame = m_loopStartFrame.load(std::memory_order_relaxed);
+	const auto loopEndFrame = m_loopEndFrame.load(std::memory_order_relaxed);
+	const auto loopSize = loopEndFrame - loopStartFrame;
 	if (loopSize == 0) { return; }
 
+	const auto distanceFromLoopStart = std::abs(state->m_frameIndex - loopStartFrame);
+	const auto distanceFromLoopEnd = std::abs(state->m_frameIndex - loopEndFrame);
+
 	switch (loopMode)
 	{
 	case Loop::On:
-		if (state->m_frameIndex < m_loopStartFrame && state->m_backwards)
+		if (state->m_frameIndex < loopStartFrame && state->m_backwards)
 		{
-			state->m_frameIndex = m_loopEndFrame - 1 - distanceFromLoopStart % loopSize;
+			state->m_frameIndex = loopEndFrame - 1 - distanceFromLoopStart % loopSize;
 		}
-		else if (state->m_frameIndex >= m_loopEndFrame)
+		else if (state->m_frameIndex >= loopEndFrame)
 		{
-			state->m_frameIndex = m_loopStartFrame + distanceFromLoopEnd % loopSize;
+			state->m_frameIndex = loopStartFrame + distanceFromLoopEnd % loopSize;
 		}
 		break;
 	case Loop::PingPong:
-		if (state->m_frameIndex < m_loopStartFrame && state->m_backwards)
+		if (state->m_frameIndex < loopStartFrame && state->m_backwards)
 		{
-			state->m_frameIndex = m_loopStartFrame + distanceFromLoopStart % loopSize;
+			state->m_frameIndex = loopStartFrame + distanceFromLoopStart % loopSize;
 			state->m_backwards = false;
 		}
-		else if (state->m_frameIndex >= m_loopEndFrame)
+		else if (state->m_frameIndex >= loopEndFrame)
 		{
-			state->m_frameIndex = m_loopEndFrame - 1 - distanceFromLoopEnd % loopSize;
+			state->m_frameIndex = loopEndFrame - 1 - distanceFromLoopEnd % loopSize;
 			state->m_backwards = true;
 		}
 		break;
@@ -1216,10 +1216,20 @@ void Song::loadProject( const QString & fileName )
 
 // only save current song as filename and do nothing else
 bool Song::saveProjectFile(const QString & filename, bool withResources)
+{
+	DataFile dataFile( DataFile::Type::SongProject );
+	saveProject( dataFile );
+
+	return dataFile.writeFile(filename, withResources);
+}
+
+
+
+
+void Song::saveProject(DataFile & dataFile)
 {
 	using gui::getGUI;
 
-	DataFile dataFile( DataFile::Type::SongProject );
 	m_savingProject = true;
 
 	m_tempoModel.saveSettings( dataFile, dataFile.head(), "bpm" );
@@ -1246,8 +1256,6 @@ bool Song::saveProjectFile(const QString & filename, bool withResources)
 	saveKeymapStates(dataFile, dataFile.content());
 
 	m_savingProject = false;
-
-	return dataFile.writeFile(filename, withResources);
 }
 
 
@@ -0,0 +1,191 @@
+/*
+ * ThreadPolicy.cpp - scheduling, CPU placement and memory locking per thread role
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "ThreadPolicy.h"
+
+#include <cstdio>
+#include <vector>
+
+#include "ConfigManager.h"
+#include "lmmsconfig.h"
+
+#ifdef LMMS_HAVE_SCHED_H
+#include <sched.h>
+#endif
+
+#ifdef LMMS_HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
+#if defined(LMMS_BUILD_LINUX) || defined(LMMS_BUILD_FREEBSD)
+#include <sys/mman.h>
+#endif
+
+namespace lmms::ThreadPolicy
+{
+
+namespace
+{
+
+struct Settings
+{
+	bool realtime = true;
+	std::vector<int> renderCpus;
+	bool isolateCpus = false;
+	bool lockMemory = false;
+};
+
+//! Read once, so threads starting later don't access the config concurrently
+const Settings& settings()
+{
+	static const Settings s = []
+	{
+		const auto config = ConfigManager::inst();
+
+		auto result = Settings{};
+		result.realtime = config->value("audioengine", "realtime", "1").toInt() != 0;
+		result.isolateCpus = config->value("audioengine", "isolatecpus", "0").toInt() != 0;
+		result.lockMemory = config->value("audioengine", "lockmemory", "0").toInt() != 0;
+
+		for (const auto& cpu : config->value("audioengine", "cpupinning").split(','))
+		{
+			bool ok = false;
+			const int index = cpu.trimmed().toInt(&ok);
+			if (ok && index >= 0) { result.renderCpus.push_back(index); }
+		}
+		return result;
+	}();
+	return s;
+}
+
+bool isRenderThread(Role role)
+{
+	return role == Role::AudioWorker || role == Role::FifoWriter || role == Role::DeviceIo;
+}
+
+void setScheduling(Role role)
+{
+#if (defined(LMMS_BUILD_LINUX) || defined(LMMS_BUILD_FREEBSD)) && defined(LMMS_HAVE_PTHREAD_H) && !defined(__OpenBSD__)
+	sched_param param{};
+	int policy = SCHED_OTHER;
+	if (isRenderThread(role) && settings().realtime)
+	{
+		policy = SCHED_FIFO;
+		param.sched_priority = (sched_get_priority_max(SCHED_FIFO) + sched_get_priority_min(SCHED_FIFO)) / 2;
+		// Device I/O only hands buffers to the sound card, and must do so in
+		// time even if all render threads are busy
+		if (role == Role::DeviceIo) { ++param.sched_priority; }
+	}
+
+	// Also resets threads that inherited real-time scheduling, e.g. when LMMS was started with chrt
+	if (pthread_setschedparam(pthread_self(), policy, &param) != 0 && policy == SCHED_FIFO)
+	{
+		printf("Notice: could not set realtime priority.\n");
+	}
+#endif
+}
+
+void setAffinity(Role role, int index)
+{
+#if defined(LMMS_BUILD_LINUX) && defined(LMMS_HAVE_SCHED_H)
+	const auto& cpus = settings().renderCpus;
+	if (cpus.empty()) { return; }
+
+	// Device I/O threads mostly wait for the device, so they aren't given
+	// a CPU of their own and keep the affinity they inherited
+	if (role == Role::DeviceIo) { return; }
+
+	cpu_set_t mask;
+	CPU_ZERO(&mask);
+	if (isRenderThread(role))
+	{
+		const int cpu = cpus[index % cpus.size()];
+		if (cpu >= CPU_SETSIZE) { return; }
+		CPU_SET(cpu, &mask);
+	}
+	else if (settings().isolateCpus)
+	{
+		if (sched_getaffinity(0, sizeof(mask), &mask) == -1) { return; }
+		for (const int cpu : cpus)
+		{
+			if (cpu < CPU_SETSIZE) { CPU_CLR(cpu, &mask); }
+		}
+		// Don't leave the thread without any CPU if all of them are reserved
+		if (CPU_COUNT(&mask) == 0) { return; }
+	}
+	else
+	{
+		return;
+	}
+
+	if (sched_setaffinity(0, sizeof(mask), &mask) == -1)
+	{
+		printf("Notice: could not set CPU affinity.\n");
+	}
+#endif
+}
+
+//! Touches the stack a render thread will use, so it doesn't page fault while rendering
+void prefaultStack()
+{
+	constexpr auto StackPrefaultSize = 256 * 1024;
+	constexpr auto PageSize = 4096;
+
+	volatile char stack[StackPrefaultSize];
+	for (int i = 0; i < StackPrefaultSize; i += PageSize)
+	{
+		stack[i] = 0;
+	}
+}
+
+} // namespace
+
+
+
+
+void applyToCurrentThread(Role role, int index)
+{
+	setScheduling(role);
+	setAffinity(role, index);
+
+	if (isRenderThread(role) && settings().lockMemory)
+	{
+		prefaultStack();
+	}
+}
+
+
+
+
+void lockMemory()
+{
+	if (!settings().lockMemory) { return; }
+
+#if defined(LMMS_BUILD_LINUX) || defined(LMMS_BUILD_FREEBSD)
+	if (mlockall(MCL_CURRENT | MCL_FUTURE) == -1)
+	{
+		printf("Notice: could not lock memory.\n");
+	}
+#endif
+}
+
+} // namespace lmms::ThreadPolicy
@@ -27,6 +27,8 @@
 #include <cstddef>
 #include <memory>
 
+#include "ThreadPolicy.h"
+
 namespace lmms {
 ThreadPool::ThreadPool(size_t numWorkers)
 {
@@ -61,6 +63,8 @@ auto ThreadPool::numWorkers() const -> size_t
 
 void ThreadPool::run()
 {
+	ThreadPolicy::applyToCurrentThread(ThreadPolicy::Role::Loader);
+
 	while (!m_done)
 	{
 		std::function<void()> task;
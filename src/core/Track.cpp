@@ -29,6 +29,9 @@
 
 #include "Track.h"
 
+#include <algorithm>
+#include <limits>
+
 #include <QDomElement>
 #include <QVariant>
 
@@ -64,7 +67,10 @@ Track::Track( Type type, TrackContainer * tc ) :
 	m_mutedModel( false, this, tr( "Mute" ) ), /*!< For controlling track muting */
 	m_soloModel( false, this, tr( "Solo" ) ), /*!< For controlling track soloing */
 	m_simpleSerializingMode( false ),
-	m_clips()        /*!< The clips (segments) */
+	m_clips(),        /*!< The clips (segments) */
+	m_clipIndexDirty( true ),
+	m_clipIndexCursor( 0 ),
+	m_clipIndexCursorTime( 0 )
 {	
 	m_trackContainer->addTrack( this );
 	m_height = -1;
@@ -327,6 +333,12 @@ Clip * Track::addClip( Clip * clip )
 {
 	m_clips.push_back( clip );
 
+	// keep the clip index in sync, also when the signals are emitted from
+	// outside the GUI thread
+	connect( clip, &Clip::positionChanged, this, &Track::invalidateClipIndex, Qt::DirectConnection );
+	connect( clip, &Clip::lengthChanged, this, &Track::invalidateClipIndex, Qt::DirectConnection );
+	invalidateClipIndex();
+
 	emit clipAdded( clip );
 
 	return clip; // just for convenience
@@ -345,6 +357,8 @@ void Track::removeClip( Clip * clip )
 	if( it != m_clips.end() )
 	{
 		m_clips.erase( it );
+		clip->disconnect( this );
+		invalidateClipIndex();
 		if( Engine::getSong() )
 		{
 			Engine::getSong()->updateLength();
@@ -441,16 +455,35 @@ int Track::getClipNum( const Clip * clip )
 void Track::getClipsInRange( clipVector & clipV, const TimePos & start,
 							const TimePos & end )
 {
-	for( Clip* clip : m_clips )
+	updateClipIndex();
+
+	const tick_t s = start;
+	const tick_t e = end;
+	const auto endsBeforeStart = [s]( const IndexedClip & entry ) { return entry.maxEnd < s; };
+
+	// maxEnd is non-decreasing, so the first entry that may overlap the range
+	// can be searched for. During playback the range only moves forward, so
+	// the search starts at the result of the previous lookup.
+	auto first = m_clipIndex.begin();
+	if( s >= m_clipIndexCursorTime && m_clipIndexCursor < m_clipIndex.size() )
 	{
-		int s = clip->startPosition();
-		int e = clip->endPosition();
-		if( ( s <= end ) && ( e >= start ) )
+		first += m_clipIndexCursor;
+	}
+	if( first != m_clipIndex.end() && endsBeforeStart( *first ) )
+	{
+		first = std::partition_point( first, m_clipIndex.end(), endsBeforeStart );
+	}
+	m_clipIndexCursor = first - m_clipIndex.begin();
+	m_clipIndexCursorTime = s;
+
+	for( auto it = first; it != m_clipIndex.end() && it->start <= e; ++it )
+	{
+		if( it->end >= s )
 		{
 			// Clip is within given range
 			// Insert sorted by Clip's position
-			clipV.insert(std::upper_bound(clipV.begin(), clipV.end(), clip, Clip::comparePosition),
-						clip);
+			clipV.insert(std::upper_bound(clipV.begin(), clipV.end(), it->clip, Clip::comparePosition),
+						it->clip);
 		}
 	}
 }
@@ -458,6 +491,45 @@ void Track::getClipsInRange( clipVector & clipV, const TimePos & start,
 
 
 
+void Track::invalidateClipIndex()
+{
+	m_clipIndexDirty = true;
+}
+
+
+
+
+/*! \brief Rebuild the clip index if clips were added, removed, moved or resized. */
+void Track::updateClipIndex()
+{
+	if( !m_clipIndexDirty.exchange( false ) )
+	{
+		return;
+	}
+
+	m_clipIndex.clear();
+	m_clipIndex.reserve( m_clips.size() );
+	for( Clip* clip : m_clips )
+	{
+		m_clipIndex.push_back( { clip->startPosition(), clip->endPosition(), 0, clip } );
+	}
+	std::stable_sort( m_clipIndex.begin(), m_clipIndex.end(),
+		[]( const IndexedClip & a, const IndexedClip & b ) { return a.start < b.start; } );
+
+	tick_t maxEnd = std::numeric_limits<tick_t>::min();
+	for( auto & entry : m_clipIndex )
+	{
+		maxEnd = std::max( maxEnd, entry.end );
+		entry.maxEnd = maxEnd;
+	}
+
+	m_clipIndexCursor = 0;
+	m_clipIndexCursorTime = 0;
+}
+
+
+
+
 /*! \brief Swap the position of two clips.
  *
  *  First, we arrange to swap the positions of the two Clips in the
@@ -31,6 +31,7 @@
 #include "AudioEngine.h"
 #include "ConfigManager.h"
 #include "Engine.h"
+#include "ThreadPolicy.h"
 
 namespace lmms
 {
@@ -242,6 +243,8 @@ void AudioAlsa::stopProcessing()
 
 void AudioAlsa::run()
 {
+	ThreadPolicy::applyToCurrentThread(ThreadPolicy::Role::DeviceIo);
+
 	auto temp = new surroundSampleFrame[audioEngine()->framesPerPeriod()];
 	auto outbuf = new int_sample_t[audioEngine()->framesPerPeriod() * channels()];
 	auto pcmbuf = new int_sample_t[m_periodSize * channels()];
@@ -23,8 +23,12 @@
  *
  */
 
+#include <algorithm>
+#include <cmath>
+
 #include <QMessageBox>
 
+#include "AudioEngine.h"
 #include "AudioFileDevice.h"
 #include "ExportProjectDialog.h"
 #include "GuiApplication.h"
@@ -38,7 +42,11 @@ AudioFileDevice::AudioFileDevice( OutputSettings const & outputSettings,
 					AudioEngine*  _audioEngine ) :
 	AudioDevice( _channels, _audioEngine ),
 	m_outputFile( _file ),
-	m_outputSettings(outputSettings)
+	m_outputSettings(outputSettings),
+	m_block( BlockFrames * _channels ),
+	m_blockFrames( 0 ),
+	m_int16Buffer( BlockFrames * _channels ),
+	m_ditherSeed( 1 )
 {
 	using gui::ExportProjectDialog;
 
@@ -91,4 +99,82 @@ int AudioFileDevice::writeData( const void* data, int len )
 	return -1;
 }
 
+
+
+
+void AudioFileDevice::writeBuffer( const surroundSampleFrame* ab, const fpp_t frames )
+{
+	const ch_cnt_t chnls = channels();
+	fpp_t written = 0;
+	while( written < frames )
+	{
+		const auto count = std::min<f_cnt_t>( frames - written, BlockFrames - m_blockFrames );
+		float* out = m_block.data() + m_blockFrames * chnls;
+		for( f_cnt_t frame = 0; frame < count; ++frame )
+		{
+			for( ch_cnt_t chnl = 0; chnl < chnls; ++chnl )
+			{
+				out[frame * chnls + chnl] = ab[written + frame][chnl];
+			}
+		}
+		written += count;
+		m_blockFrames += count;
+
+		if( m_blockFrames == BlockFrames )
+		{
+			flushBlock();
+		}
+	}
+}
+
+
+
+
+void AudioFileDevice::flushBlock()
+{
+	if( m_blockFrames > 0 )
+	{
+		encodeBlock( m_block.data(), m_blockFrames );
+		m_blockFrames = 0;
+	}
+}
+
+
+
+
+const int_sample_t* AudioFileDevice::convertToInt16( const float* interleaved, f_cnt_t frames )
+{
+	const auto samples = static_cast<std::size_t>( frames ) * channels();
+	if( m_int16Buffer.size() < samples )
+	{
+		m_int16Buffer.resize( samples );
+	}
+	int_sample_t* out = m_int16Buffer.data();
+
+	if( !m_outputSettings.dither() )
+	{
+		for( std::size_t i = 0; i < samples; ++i )
+		{
+			out[i] = static_cast<int_sample_t>( std::clamp( interleaved[i], -1.f, 1.f ) * OUTPUT_SAMPLE_MULTIPLIER );
+		}
+		return out;
+	}
+
+	// TPDF dither: the difference of two uniform random values spans +-1 LSB
+	auto seed = m_ditherSeed;
+	const auto nextRandom = [&seed]
+	{
+		seed = seed * 1664525u + 1013904223u;
+		return static_cast<float>( seed >> 8 ) * ( 1.f / 16777216.f );
+	};
+	for( std::size_t i = 0; i < samples; ++i )
+	{
+		const float noise = nextRandom() - nextRandom();
+		const float value = std::clamp( interleaved[i], -1.f, 1.f ) * OUTPUT_SAMPLE_MULTIPLIER + noise;
+		out[i] = static_cast<int_sample_t>( std::clamp( std::floor( value + 0.5f ), -32768.f, 32767.f ) );
+	}
+	m_ditherSeed = seed;
+	return out;
+}
+
 } // namespace lmms
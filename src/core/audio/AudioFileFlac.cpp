@@ -24,11 +24,10 @@
 
 #include <QtGlobal>
 
+#include <algorithm>
 #include <cmath>
-#include <memory>
 
 #include "AudioFileFlac.h"
-#include "endian_handling.h"
 #include "AudioEngine.h"
 
 namespace lmms
@@ -89,33 +88,27 @@ bool AudioFileFlac::startEncoding()
 	return true;
 }
 
-void AudioFileFlac::writeBuffer(surroundSampleFrame const* _ab, fpp_t const frames)
+void AudioFileFlac::encodeBlock(float* interleaved, f_cnt_t frames)
 {
 	OutputSettings::BitDepth depth = getOutputSettings().getBitDepth();
-	float clipvalue = std::nextafterf( -1.0f, 0.0f );
 
 	if (depth == OutputSettings::BitDepth::Depth24Bit || depth == OutputSettings::BitDepth::Depth32Bit) // Float encoding
 	{
-		auto buf = std::vector<sample_t>(frames * channels());
-		for(fpp_t frame = 0; frame < frames; ++frame)
+		const float clipvalue = std::nextafterf(-1.0f, 0.0f);
+		const auto samples = static_cast<std::size_t>(frames) * channels();
+		for (std::size_t i = 0; i < samples; ++i)
 		{
-			for(ch_cnt_t channel=0; channel<channels(); ++channel)
-			{
-				// Clip the negative side to just above -1.0 in order to prevent it from changing sign
-				// Upstream issue: https://github.com/erikd/libsndfile/issues/309
-				// When this commit is reverted libsndfile-1.0.29 must be made a requirement for FLAC
-				buf[frame*channels() + channel] = std::max(clipvalue, _ab[frame][channel]);
-			}
+			// Clip the negative side to just above -1.0 in order to prevent it from changing sign
+			// Upstream issue: https://github.com/erikd/libsndfile/issues/309
+			// When this commit is reverted libsndfile-1.0.29 must be made a requirement for FLAC
+			interleaved[i] = std::max(clipvalue, interleaved[i]);
 		}
-		sf_writef_float(m_sf, static_cast<float*>(buf.data()), frames);
+		sf_writef_float(m_sf, interleaved, frames);
 	}
 	else // integer PCM encoding
 	{
-		auto buf = std::vector<int_sample_t>(frames * channels());
-		convertToS16(_ab, frames, buf.data(), !isLittleEndian());
-		sf_writef_short(m_sf, static_cast<short*>(buf.data()), frames);
+		sf_writef_short(m_sf, convertToInt16(interleaved, frames), frames);
 	}
-
 }
 
 
@@ -123,6 +116,7 @@ void AudioFileFlac::finishEncoding()
 {
 	if (m_sf)
 	{
+		flushBlock();
 		sf_write_sync(m_sf);
 		sf_close(m_sf);
 	}
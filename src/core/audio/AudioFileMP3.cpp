@@ -53,38 +53,39 @@ AudioFileMP3::~AudioFileMP3()
 	tearDownEncoder();
 }
 
-void AudioFileMP3::writeBuffer(const surroundSampleFrame* _buf, const fpp_t _frames)
+void AudioFileMP3::encodeBlock(float* interleaved, f_cnt_t frames)
 {
-	if (_frames < 1)
+	if (frames < 1)
 	{
 		return;
 	}
 
-	std::vector<float> interleavedDataBuffer(_frames * 2);
-	for (fpp_t i = 0; i < _frames; ++i)
+	size_t minimumBufferSize = 1.25 * frames + 7200;
+	if (m_encodingBuffer.size() < minimumBufferSize)
 	{
-		interleavedDataBuffer[2*i] = _buf[i][0];
-		interleavedDataBuffer[2*i + 1] = _buf[i][1];
+		m_encodingBuffer.resize(minimumBufferSize);
 	}
 
-	size_t minimumBufferSize = 1.25 * _frames + 7200;
-	std::vector<unsigned char> encodingBuffer(minimumBufferSize);
-
-	int bytesWritten = lame_encode_buffer_interleaved_ieee_float(m_lame, &interleavedDataBuffer[0], _frames, &encodingBuffer[0], static_cast<int>(encodingBuffer.size()));
+	int bytesWritten = lame_encode_buffer_interleaved_ieee_float(m_lame, interleaved, frames, m_encodingBuffer.data(), static_cast<int>(m_encodingBuffer.size()));
 	assert (bytesWritten >= 0);
 
-	writeData(&encodingBuffer[0], bytesWritten);
+	writeData(m_encodingBuffer.data(), bytesWritten);
 }
 
 void AudioFileMP3::flushRemainingBuffers()
 {
+	flushBlock();
+
 	// The documentation states that flush should have at least 7200 bytes. So let's be generous.
-	std::vector<unsigned char> encodingBuffer(7200 * 4);
+	if (m_encodingBuffer.size() < 7200 * 4)
+	{
+		m_encodingBuffer.resize(7200 * 4);
+	}
 
-	int bytesWritten = lame_encode_flush(m_lame, &encodingBuffer[0], static_cast<int>(encodingBuffer.size()));
+	int bytesWritten = lame_encode_flush(m_lame, m_encodingBuffer.data(), static_cast<int>(m_encodingBuffer.size()));
 	assert (bytesWritten >= 0);
 
-	writeData(&encodingBuffer[0], bytesWritten);
+	writeData(m_encodingBuffer.data(), bytesWritten);
 }
 
 MPEG_mode mapToMPEG_mode(OutputSettings::StereoMode stereoMode)
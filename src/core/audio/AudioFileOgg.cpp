@@ -179,22 +179,25 @@ bool AudioFileOgg::startEncoding()
 	return true;
 }
 
-void AudioFileOgg::writeBuffer(const surroundSampleFrame* _ab, const fpp_t _frames)
+void AudioFileOgg::encodeBlock(float* interleaved, f_cnt_t frames)
 {
 	int eos = 0;
 
-	float * * buffer = vorbis_analysis_buffer( &m_vd, _frames *
-							BYTES_PER_SAMPLE *
-								channels() );
-	for( fpp_t frame = 0; frame < _frames; ++frame )
+	// Passing no frames marks the end of the stream
+	if (frames > 0)
 	{
-		for( ch_cnt_t chnl = 0; chnl < channels(); ++chnl )
+		float** buffer = vorbis_analysis_buffer(&m_vd, frames);
+		for (ch_cnt_t chnl = 0; chnl < m_channels; ++chnl)
 		{
-			buffer[chnl][frame] = _ab[frame][chnl];
+			float* out = buffer[chnl];
+			for (f_cnt_t frame = 0; frame < frames; ++frame)
+			{
+				out[frame] = interleaved[frame * m_channels + chnl];
+			}
 		}
 	}
 
-	vorbis_analysis_wrote( &m_vd, _frames );
+	vorbis_analysis_wrote( &m_vd, frames );
 
 	// While we can get enough data from the library to analyse,
 	// one block at a time...
@@ -246,8 +249,10 @@ void AudioFileOgg::finishEncoding()
 {
 	if( m_ok )
 	{
+		flushBlock();
+
 		// just for flushing buffers...
-		writeBuffer(nullptr, 0);
+		encodeBlock(nullptr, 0);
 
 		// clean up
 		ogg_stream_clear( &m_os );
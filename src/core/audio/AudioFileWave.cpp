@@ -24,7 +24,6 @@
  */
 
 #include "AudioFileWave.h"
-#include "endian_handling.h"
 #include "AudioEngine.h"
 
 
@@ -93,30 +92,16 @@ bool AudioFileWave::startEncoding()
 	return true;
 }
 
-void AudioFileWave::writeBuffer(const surroundSampleFrame* _ab, const fpp_t _frames)
+void AudioFileWave::encodeBlock( float* interleaved, f_cnt_t frames )
 {
-	OutputSettings::BitDepth bitDepth = getOutputSettings().getBitDepth();
-
-	if( bitDepth == OutputSettings::BitDepth::Depth32Bit || bitDepth == OutputSettings::BitDepth::Depth24Bit )
+	if( getOutputSettings().getBitDepth() == OutputSettings::BitDepth::Depth16Bit )
 	{
-		auto buf = new float[_frames * channels()];
-		for( fpp_t frame = 0; frame < _frames; ++frame )
-		{
-			for( ch_cnt_t chnl = 0; chnl < channels(); ++chnl )
-			{
-				buf[frame * channels() + chnl] = _ab[frame][chnl];
-			}
-		}
-		sf_writef_float( m_sf, buf, _frames );
-		delete[] buf;
+		// libsndfile expects the samples in native byte order
+		sf_writef_short( m_sf, convertToInt16( interleaved, frames ), frames );
 	}
 	else
 	{
-		auto buf = new int_sample_t[_frames * channels()];
-		convertToS16(_ab, _frames, buf, !isLittleEndian());
-
-		sf_writef_short( m_sf, buf, _frames );
-		delete[] buf;
+		sf_writef_float( m_sf, interleaved, frames );
 	}
 }
 
@@ -127,6 +112,7 @@ void AudioFileWave::finishEncoding()
 {
 	if( m_sf )
 	{
+		flushBlock();
 		sf_close( m_sf );
 	}
 }
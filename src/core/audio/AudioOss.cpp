@@ -34,6 +34,7 @@
 #include "LcdSpinBox.h"
 #include "AudioEngine.h"
 #include "Engine.h"
+#include "ThreadPolicy.h"
 
 #ifdef LMMS_HAVE_UNISTD_H
 #include <unistd.h>
@@ -256,6 +257,8 @@ void AudioOss::stopProcessing()
 
 void AudioOss::run()
 {
+	ThreadPolicy::applyToCurrentThread(ThreadPolicy::Role::DeviceIo);
+
 	auto temp = new surroundSampleFrame[audioEngine()->framesPerPeriod()];
 	auto outbuf = new int_sample_t[audioEngine()->framesPerPeriod() * channels()];
 
@@ -33,6 +33,7 @@
 #include "LcdSpinBox.h"
 #include "AudioEngine.h"
 #include "Engine.h"
+#include "ThreadPolicy.h"
 
 namespace lmms
 {
@@ -189,6 +190,8 @@ static void context_state_callback(pa_context *c, void *userdata)
 
 void AudioPulseAudio::run()
 {
+	ThreadPolicy::applyToCurrentThread(ThreadPolicy::Role::DeviceIo);
+
 	pa_mainloop * mainLoop = pa_mainloop_new();
 	if( !mainLoop )
 	{
@@ -35,6 +35,7 @@
 #include "LcdSpinBox.h"
 #include "AudioEngine.h"
 #include "Engine.h"
+#include "ThreadPolicy.h"
 
 #include "ConfigManager.h"
 
@@ -141,6 +142,8 @@ void AudioSndio::stopProcessing()
 
 void AudioSndio::run()
 {
+	ThreadPolicy::applyToCurrentThread(ThreadPolicy::Role::DeviceIo);
+
 	surroundSampleFrame * temp = new surroundSampleFrame[audioEngine()->framesPerPeriod()];
 	int_sample_t * outbuf = new int_sample_t[audioEngine()->framesPerPeriod() * channels()];
 
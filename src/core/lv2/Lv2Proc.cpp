@@ -26,7 +26,9 @@
 
 #ifdef LMMS_HAVE_LV2
 
+#include <algorithm>
 #include <cmath>
+#include <utility>
 #include <lv2/midi/midi.h>
 #include <lv2/atom/atom.h>
 #include <lv2/resize-port/resize-port.h>
@@ -46,6 +48,7 @@
 #include "MidiEvent.h"
 #include "MidiEventToByteSeq.h"
 #include "NoCopyNoMove.h"
+#include "ValueBuffer.h"
 
 
 namespace lmms
@@ -227,53 +230,85 @@ void Lv2Proc::dumpPorts()
 
 
 
-void Lv2Proc::copyModelsFromCore()
+namespace
 {
-	struct FloatFromModelVisitor : public ConstModelVisitor
-	{
-		const std::vector<float>* m_scalePointMap; // in
-		float m_res; // out
-		void visit(const FloatModel& m) override { m_res = m.value(); }
-		void visit(const IntModel& m) override {
-			m_res = static_cast<float>(m.value()); }
-		void visit(const BoolModel& m) override {
-			m_res = static_cast<float>(m.value()); }
-		void visit(const ComboBoxModel& m) override {
-			m_res = (*m_scalePointMap)[static_cast<std::size_t>(m.value())]; }
-	};
 
-	struct Copy : public Lv2Ports::Visitor
+struct FloatFromModelVisitor : public ConstModelVisitor
+{
+	const std::vector<float>* m_scalePointMap; // in
+	float m_res; // out
+	void visit(const FloatModel& m) override { m_res = m.value(); }
+	void visit(const IntModel& m) override {
+		m_res = static_cast<float>(m.value()); }
+	void visit(const BoolModel& m) override {
+		m_res = static_cast<float>(m.value()); }
+	void visit(const ComboBoxModel& m) override {
+		m_res = (*m_scalePointMap)[static_cast<std::size_t>(m.value())]; }
+};
+
+float portValueFromModel(const Lv2Ports::ControlPortBase& port)
+{
+	FloatFromModelVisitor ffm;
+	ffm.m_scalePointMap = &port.m_scalePointMap;
+	port.m_connectedModel->accept(ffm);
+	return ffm.m_res;
+}
+
+//! Whether the port's model value may differ from the one copied in the last period
+bool modelValueChanged(Lv2Ports::ControlPortBase& port)
+{
+	AutomatableModel& model = *port.m_connectedModel;
+	// isValueChanged() resets the flag, so it must always be called.
+	// Values from controllers and linked models change without setting it,
+	// and removing the controller or link does not set it either.
+	const bool changed = model.isValueChanged();
+	const bool controlled = model.controllerConnection() || model.hasLinkedModels();
+	const bool wasControlled = std::exchange(port.m_wasControlled, controlled);
+	return changed || controlled || wasControlled;
+}
+
+} // namespace
+
+
+
+
+void Lv2Proc::copyModelsFromCore()
+{
+	// feed each input port with the respective data from the LMMS core
+	for (Lv2Ports::Control* ctrl : m_controlInputs)
 	{
-		void visit(Lv2Ports::Control& ctrl) override
+		if (modelValueChanged(*ctrl) || m_syncAllControls)
 		{
-			FloatFromModelVisitor ffm;
-			ffm.m_scalePointMap = &ctrl.m_scalePointMap;
-			ctrl.m_connectedModel->accept(ffm);
-			ctrl.m_val = ffm.m_res;
+			ctrl->m_val = portValueFromModel(*ctrl);
 		}
-		void visit(Lv2Ports::Cv& cv) override
+	}
+
+	for (Lv2Ports::Cv* cv : m_cvInputs)
+	{
+		AutomatableModel& model = *cv->m_connectedModel;
+		const ValueBuffer* values = cv->m_scalePointMap.empty() ? model.valueBuffer() : nullptr;
+		if (values)
 		{
-			FloatFromModelVisitor ffm;
-			ffm.m_scalePointMap = &cv.m_scalePointMap;
-			cv.m_connectedModel->accept(ffm);
-			// dirty fix, needs better interpolation
-			std::fill(cv.m_buffer.begin(), cv.m_buffer.end(), ffm.m_res);
+			// sample-exact automation or controllers
+			const auto count = std::min(static_cast<std::size_t>(values->length()), cv->m_buffer.size());
+			std::copy_n(values->values(), count, cv->m_buffer.begin());
+			std::fill(cv->m_buffer.begin() + count, cv->m_buffer.end(), values->value(values->length() - 1));
+			// copy the model's value once the buffer is gone
+			cv->m_wasControlled = true;
 		}
-		void visit(Lv2Ports::AtomSeq& atomPort) override
+		else if (modelValueChanged(*cv) || m_syncAllControls)
 		{
-			lv2_evbuf_reset(atomPort.m_buf.get(), true);
+			std::fill(cv->m_buffer.begin(), cv->m_buffer.end(), portValueFromModel(*cv));
 		}
-	} copy;
+	}
 
-	// feed each input port with the respective data from the LMMS core
-	for (const std::unique_ptr<Lv2Ports::PortBase>& port : m_ports)
+	for (Lv2Ports::AtomSeq* atomPort : m_atomInputs)
 	{
-		if (port->m_flow == Lv2Ports::Flow::Input)
-		{
-			port->accept(copy);
-		}
+		lv2_evbuf_reset(atomPort->m_buf.get(), true);
 	}
 
+	m_syncAllControls = false;
+
 	// send pending MIDI events to atom port
 	if(m_midiIn)
 	{
@@ -736,6 +771,15 @@ void Lv2Proc::createPorts()
 										m_proc->m_plugin, ctrl.m_port)),
 					amo);
 				m_proc->addModel(amo, ctrl.uri());
+				m_proc->m_controlInputs.push_back(&ctrl);
+			}
+		}
+
+		void visit(Lv2Ports::Cv& cv) override
+		{
+			if (cv.m_flow == Lv2Ports::Flow::Input && cv.m_connectedModel)
+			{
+				m_proc->m_cvInputs.push_back(&cv);
 			}
 		}
 
@@ -766,6 +810,7 @@ void Lv2Proc::createPorts()
 		{
 			if(atomPort.m_flow == Lv2Ports::Flow::Input)
 			{
+				m_proc->m_atomInputs.push_back(&atomPort);
 				if(atomPort.flags & Lv2Ports::AtomSeq::FlagType::Midi)
 				{
 					// take any MIDI input, prefer mandatory MIDI input
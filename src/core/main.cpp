@@ -43,10 +43,6 @@
 #include <windows.h>
 #endif
 
-#ifdef LMMS_HAVE_SCHED_H
-#include "sched.h"
-#endif
-
 #ifdef LMMS_HAVE_PROCESS_H
 #include <process.h>
 #endif
@@ -75,6 +71,7 @@
 #include "ProjectRenderer.h"
 #include "RenderManager.h"
 #include "Song.h"
+#include "ThreadPolicy.h"
 
 #ifdef LMMS_DEBUG_FPE
 #include <fenv.h> // For feenableexcept
@@ -191,6 +188,8 @@ void printHelp()
 		"  -a, --float                    Use 32bit float bit depth\n"
 		"  -b, --bitrate <bitrate>        Specify output bitrate in KBit/s\n"
 		"          Default: 160.\n"
+		"      --dither                   Apply TPDF dither when rendering\n"
+		"          16 bit output.\n"
 		"  -f, --format <format>         Specify format of render-output where\n"
 		"          Format is either 'wav', 'flac', 'ogg' or 'mp3'.\n"
 		"  -i, --interpolation <method>   Specify interpolation method\n"
@@ -625,6 +624,10 @@ int main( int argc, char * * argv )
 		{
 			os.setBitDepth(OutputSettings::BitDepth::Depth32Bit);
 		}
+		else if( arg == "--dither" )
+		{
+			os.setDither(true);
+		}
 		else if( arg == "--interpolation" || arg == "-i" )
 		{
 			++i;
@@ -744,20 +747,9 @@ int main( int argc, char * * argv )
 	loadTranslation(QString("qt_") + pos, ConfigManager::inst()->localeDir());
 
 
-	// try to set realtime priority
-#if defined(LMMS_BUILD_LINUX) || defined(LMMS_BUILD_FREEBSD)
-#ifdef LMMS_HAVE_SCHED_H
-#ifndef __OpenBSD__
-	struct sched_param sparam;
-	sparam.sched_priority = ( sched_get_priority_max( SCHED_FIFO ) +
-				sched_get_priority_min( SCHED_FIFO ) ) / 2;
-	if( sched_setscheduler( 0, SCHED_FIFO, &sparam ) == -1 )
-	{
-		printf( "Notice: could not set realtime priority.\n" );
-	}
-#endif
-#endif // LMMS_HAVE_SCHED_H
-#endif
+	// only the render threads get realtime priority, see ThreadPolicy
+	ThreadPolicy::lockMemory();
+	ThreadPolicy::applyToCurrentThread(ThreadPolicy::Role::Gui);
 
 #ifdef LMMS_BUILD_WIN32
 	if( !SetPriorityClass( GetCurrentProcess(), HIGH_PRIORITY_CLASS ) )
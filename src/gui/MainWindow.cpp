@@ -24,6 +24,8 @@
 
 #include "MainWindow.h"
 
+#include <memory>
+
 #include <QApplication>
 #include <QCloseEvent>
 #include <QDesktopServices>
@@ -32,12 +34,14 @@
 #include <QMdiArea>
 #include <QMenuBar>
 #include <QMessageBox>
+#include <QSaveFile>
 #include <QShortcut>
 #include <QSplitter>
 
 #include "AboutDialog.h"
 #include "AutomationEditor.h"
 #include "ControllerRackView.h"
+#include "DataFile.h"
 #include "embed.h"
 #include "Engine.h"
 #include "ExportProjectDialog.h"
@@ -66,6 +70,7 @@
 #include "SubWindow.h"
 #include "TemplatesMenu.h"
 #include "TextFloat.h"
+#include "ThreadPool.h"
 #include "TimeLineWidget.h"
 #include "ToolButton.h"
 #include "ToolPlugin.h"
@@ -254,6 +259,7 @@ MainWindow::~MainWindow()
 	delete getGUI()->automationEditor();
 	delete getGUI()->pianoRoll();
 	delete getGUI()->songEditor();
+	waitForAutoSave();
 	// destroy engine which will do further cleanups etc.
 	Engine::destroy();
 }
@@ -1270,7 +1276,9 @@ void MainWindow::closeEvent( QCloseEvent * _ce )
 
 void MainWindow::sessionCleanup()
 {
-	// delete recover session files
+	// delete recover session files, but not before a pending autosave
+	// could write them again
+	waitForAutoSave();
 	QFile::remove( ConfigManager::inst()->recoveryFile() );
 	setSession( SessionState::Normal );
 }
@@ -1353,7 +1361,12 @@ void MainWindow::keyReleaseEvent( QKeyEvent * _ke )
 
 void MainWindow::timerEvent( QTimerEvent * _te)
 {
-	emit periodicUpdate();
+	// Everything refreshed periodically is part of this window, and minimized
+	// windows still count as visible, so stop the refreshes here
+	if( !isMinimized() )
+	{
+		emit periodicUpdate();
+	}
 }
 
 
@@ -1384,7 +1397,11 @@ void MainWindow::browseHelp()
 
 void MainWindow::autoSave()
 {
-	if( !Engine::getSong()->isExporting() &&
+	const bool savePending = m_autoSaveResult.valid()
+		&& m_autoSaveResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+
+	if( !savePending &&
+		!Engine::getSong()->isExporting() &&
 		!Engine::getSong()->isLoadingProject() &&
 		!RemotePluginBase::isMainThreadWaiting() &&
 		!QApplication::mouseButtons() &&
@@ -1392,7 +1409,24 @@ void MainWindow::autoSave()
 				"enablerunningautosave" ).toInt() ||
 			! Engine::getSong()->isPlaying() ) )
 	{
-		Engine::getSong()->saveProjectFile(ConfigManager::inst()->recoveryFile());
+		if (m_autoSaveResult.valid() && !m_autoSaveResult.get())
+		{
+			qWarning("Could not write the recovery file");
+		}
+
+		// Only gathering the project state has to happen here. Writing the
+		// document, compressing and storing it is done in the background.
+		auto dataFile = std::make_shared<DataFile>(DataFile::Type::SongProject);
+		Engine::getSong()->saveProject(*dataFile);
+
+		const QString fileName = ConfigManager::inst()->recoveryFile();
+		m_autoSaveResult = ThreadPool::instance().enqueue([dataFile, fileName]
+		{
+			QSaveFile file(fileName);
+			if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) { return false; }
+			file.write(dataFile->serialize(fileName.endsWith(".mmpz")));
+			return file.commit();
+		});
 		autoSaveTimerReset();  // Reset timer
 	}
 	else
@@ -1405,6 +1439,17 @@ void MainWindow::autoSave()
 	}
 }
 
+void MainWindow::waitForAutoSave()
+{
+	if (m_autoSaveResult.valid())
+	{
+		m_autoSaveResult.wait();
+	}
+}
+
+
+
+
 void MainWindow::onExportProjectMidi()
 {
 	FileDialog efd( this );
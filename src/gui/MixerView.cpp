@@ -555,32 +555,39 @@ void MixerView::clear()
 void MixerView::updateFaders()
 {
 	Mixer * m = getMixer();
+	const float fallOff = 1.25;
 
 	for (int i = 0; i < m_mixerChannelViews.size(); ++i)
 	{
-		const float opl = m_mixerChannelViews[i]->m_fader->getPeak_L();
-		const float opr = m_mixerChannelViews[i]->m_fader->getPeak_R();
-		const float fallOff = 1.25;
-		if (m->mixerChannel(i)->m_peakLeft >= opl/fallOff)
+		// Take the peaks even if the fader is not shown, so it does not show
+		// stale values when it is scrolled back into view
+		MixerChannel* channel = m->mixerChannel(i);
+		const float peakLeft = channel->takePeakLeft();
+		const float peakRight = channel->takePeakRight();
+
+		Fader* fader = m_mixerChannelViews[i]->m_fader;
+		if (fader->visibleRegion().isEmpty()) { continue; }
+
+		// A negative peak means that the channel has not been processed since
+		// the last update, so the meter is left as it is
+		const float opl = fader->getPeak_L();
+		if (peakLeft >= opl / fallOff)
 		{
-			m_mixerChannelViews[i]->m_fader->setPeak_L(m->mixerChannel(i)->m_peakLeft);
-			// Set to -1 so later we'll know if this value has been refreshed yet.
-			m->mixerChannel(i)->m_peakLeft = -1;
+			fader->setPeak_L(peakLeft);
 		}
-		else if (m->mixerChannel(i)->m_peakLeft != -1)
+		else if (peakLeft >= 0)
 		{
-			m_mixerChannelViews[i]->m_fader->setPeak_L(opl/fallOff);
+			fader->setPeak_L(opl / fallOff);
 		}
 
-		if (m->mixerChannel(i)->m_peakRight >= opr/fallOff)
+		const float opr = fader->getPeak_R();
+		if (peakRight >= opr / fallOff)
 		{
-			m_mixerChannelViews[i]->m_fader->setPeak_R(m->mixerChannel(i)->m_peakRight);
-			// Set to -1 so later we'll know if this value has been refreshed yet.
-			m->mixerChannel(i)->m_peakRight = -1;
+			fader->setPeak_R(peakRight);
 		}
-		else if (m->mixerChannel(i)->m_peakRight != -1)
+		else if (peakRight >= 0)
 		{
-			m_mixerChannelViews[i]->m_fader->setPeak_R(opr/fallOff);
+			fader->setPeak_R(opr / fallOff);
 		}
 	}
 }
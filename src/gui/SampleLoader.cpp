@@ -25,8 +25,13 @@
 #include "SampleLoader.h"
 
 #include <QFileInfo>
+#include <QHash>
 #include <QMessageBox>
+#include <QSet>
 #include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 #include "ConfigManager.h"
 #include "FileDialog.h"
@@ -34,8 +39,18 @@
 #include "PathUtil.h"
 #include "SampleDecoder.h"
 #include "Song.h"
+#include "ThreadPool.h"
 
 namespace lmms::gui {
+
+namespace {
+
+//! Buffers decoded by preloadFiles(), by absolute path
+QHash<QString, std::shared_ptr<const SampleBuffer>> s_preloadedBuffers;
+std::mutex s_preloadedBuffersMutex;
+
+} // namespace
+
 QString SampleLoader::openAudioFile(const QString& previousFile)
 {
 	auto openFileDialog = FileDialog(nullptr, QObject::tr("Open audio file"));
@@ -92,6 +107,12 @@ std::shared_ptr<const SampleBuffer> SampleLoader::createBufferFromFile(const QSt
 {
 	if (filePath.isEmpty()) { return SampleBuffer::emptyBuffer(); }
 
+	{
+		const auto lock = std::lock_guard{s_preloadedBuffersMutex};
+		const auto it = s_preloadedBuffers.constFind(PathUtil::toAbsolute(filePath));
+		if (it != s_preloadedBuffers.constEnd()) { return *it; }
+	}
+
 	try
 	{
 		return std::make_shared<SampleBuffer>(filePath);
@@ -118,6 +139,49 @@ std::shared_ptr<const SampleBuffer> SampleLoader::createBufferFromBase64(const Q
 	}
 }
 
+void SampleLoader::preloadFiles(const QStringList& filePaths)
+{
+	auto pending = std::vector<std::pair<QString, std::future<std::shared_ptr<const SampleBuffer>>>>{};
+	auto queued = QSet<QString>{};
+	for (const auto& filePath : filePaths)
+	{
+		if (filePath.isEmpty()) { continue; }
+
+		const auto absolutePath = PathUtil::toAbsolute(filePath);
+		if (queued.contains(absolutePath)) { continue; }
+		queued.insert(absolutePath);
+
+		pending.emplace_back(absolutePath, ThreadPool::instance().enqueue(
+			[filePath]() -> std::shared_ptr<const SampleBuffer>
+			{
+				try
+				{
+					return std::make_shared<SampleBuffer>(filePath);
+				}
+				catch (const std::runtime_error&)
+				{
+					// createBufferFromFile() will try again and report the error
+					return nullptr;
+				}
+			}));
+	}
+
+	for (auto& [absolutePath, buffer] : pending)
+	{
+		if (auto decoded = buffer.get())
+		{
+			const auto lock = std::lock_guard{s_preloadedBuffersMutex};
+			s_preloadedBuffers.insert(absolutePath, std::move(decoded));
+		}
+	}
+}
+
+void SampleLoader::releasePreloadedBuffers()
+{
+	const auto lock = std::lock_guard{s_preloadedBuffersMutex};
+	s_preloadedBuffers.clear();
+}
+
 void SampleLoader::displayError(const QString& message)
 {
 	QMessageBox::critical(nullptr, QObject::tr("Error loading sample"), message);
@@ -705,6 +705,7 @@ void PianoRoll::glueNotes()
 		{
 			m_midiClip->removeNote(noteToRemove[i]);
 		}
+		m_midiClip->updateLength();
 
 		update();
 	}
@@ -758,6 +759,7 @@ void PianoRoll::fitNoteLengths(bool fill)
 			note->setLength(length);
 		}
 	}
+	m_midiClip->updateLength();
 
 	update();
 	getGUI()->songEditor()->update();
@@ -781,6 +783,7 @@ void PianoRoll::constrainNoteLengths(bool constrainMax)
 			note->setLength(bound);
 		}
 	}
+	m_midiClip->updateLength();
 
 	update();
 	getGUI()->songEditor()->update();
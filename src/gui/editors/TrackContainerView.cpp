@@ -40,6 +40,7 @@
 #include "PatternTrack.h"
 #include "Song.h"
 #include "StringPairDrag.h"
+#include "ThreadPolicy.h"
 #include "TrackView.h"
 #include "GuiApplication.h"
 #include "PluginFactory.h"
@@ -63,6 +64,8 @@ InstrumentLoaderThread::InstrumentLoaderThread( QObject *parent, InstrumentTrack
 
 void InstrumentLoaderThread::run()
 {
+	ThreadPolicy::applyToCurrentThread(ThreadPolicy::Role::Loader);
+
 	Instrument *i = m_it->loadInstrument(m_name, nullptr,
 										 true /*always DnD*/);
 	QObject *parent = i->parent();
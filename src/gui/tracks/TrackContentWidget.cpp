@@ -28,6 +28,7 @@
 #include <QContextMenuEvent>
 #include <QMenu>
 #include <QPainter>
+#include <QPixmapCache>
 
 #include "AutomationClip.h"
 #include "Clipboard.h"
@@ -124,6 +125,23 @@ void TrackContentWidget::updateBackground()
 
 	int w = ppb * BARS_PER_GROUP;
 	int h = height();
+
+	// All lanes of the same height share their background at a given zoom
+	// level, so it only has to be drawn once for all tracks
+	const QString cacheKey = QString( "TrackContentWidget:%1:%2:%3:%4:%5:%6:%7:%8:%9" )
+		.arg( ppb ).arg( h ).arg( fineGridResolution ).arg( coarseGridResolution )
+		.arg( darkerColor().color().rgba() ).arg( lighterColor().color().rgba() )
+		.arg( fineGridColor().color().rgba() ).arg( coarseGridColor().color().rgba() )
+		.arg( QString( "%1:%2:%3:%4:%5:%6:%7" )
+			.arg( embossColor().color().rgba() ).arg( horizontalColor().color().rgba() )
+			.arg( fineGridWidth() ).arg( coarseGridWidth() ).arg( embossWidth() )
+			.arg( embossOffset() ).arg( horizontalWidth() ) );
+	if( QPixmapCache::find( cacheKey, &m_background ) )
+	{
+		update();
+		return;
+	}
+
 	m_background = QPixmap( w * 2, height() );
 	QPainter pmp( &m_background );
 
@@ -157,6 +175,8 @@ void TrackContentWidget::updateBackground()
 
 	pmp.end();
 
+	QPixmapCache::insert( cacheKey, m_background );
+
 	// Force redraw
 	update();
 }
@@ -270,7 +290,8 @@ void TrackContentWidget::changePosition( const TimePos & newPos )
 	{
 		Clip* clip = clipView->getClip();
 
-		clip->changeLength( clip->length() );
+		// the width of the view depends on the zoom level
+		clipView->updateLength();
 
 		const int ts = clip->startPosition();
 		const int te = clip->endPosition()-3;
@@ -46,6 +46,8 @@
 
 #include "Fader.h"
 
+#include <algorithm>
+
 #include <QInputDialog>
 #include <QMouseEvent>
 #include <QPainter>
@@ -207,6 +209,9 @@ void Fader::wheelEvent (QWheelEvent* ev)
 ///
 void Fader::setPeak(float fPeak, float& targetPeak, float& persistentPeak, QElapsedTimer& lastPeakTimer)
 {
+	const int oldPeakY = peakToY(targetPeak);
+	const int oldPersistentPeakY = peakToY(persistentPeak);
+
 	if (targetPeak != fPeak)
 	{
 		targetPeak = fPeak;
@@ -216,19 +221,41 @@ void Fader::setPeak(float fPeak, float& targetPeak, float& persistentPeak, QElap
 			lastPeakTimer.restart();
 			emit peakChanged(persistentPeak);
 		}
-		update();
 	}
 
 	if (persistentPeak > 0 && lastPeakTimer.elapsed() > 1500)
 	{
 		persistentPeak = qMax<float>(0, persistentPeak-0.05);
 		emit peakChanged(persistentPeak);
+	}
+
+	// Falling meters change their value on every refresh, but most of these
+	// changes are smaller than a pixel and would not change anything on screen
+	if (peakToY(targetPeak) != oldPeakY || peakToY(persistentPeak) != oldPersistentPeakY)
+	{
 		update();
 	}
 }
 
 
 
+int Fader::peakToY(float peak) const
+{
+	// Must match the mapping used in paintLevels
+	const auto mapper = [this](float value)
+	{
+		return m_levelsDisplayedInDBFS ? ampToDbfs(qMax(0.0001f, value)) : value;
+	};
+
+	const float mappedMinPeak = mapper(m_fMinPeak);
+	const float mappedMaxPeak = mapper(m_fMaxPeak);
+	const LinearMap<float> valuesToWindowCoordinates(mappedMaxPeak, 2.f, mappedMinPeak, height() - 2.f);
+
+	return static_cast<int>(valuesToWindowCoordinates.map(std::clamp(mapper(peak), mappedMinPeak, mappedMaxPeak)));
+}
+
+
+
 void Fader::setPeak_L(float fPeak)
 {
 	setPeak(fPeak, m_fPeakValue_L, m_persistentPeak_L, m_lastPeakTimer_L);
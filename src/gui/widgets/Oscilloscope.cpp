@@ -23,6 +23,8 @@
  */
 
 
+#include <algorithm>
+
 #include <QMouseEvent>
 #include <QPainter>
 
@@ -45,6 +47,8 @@ Oscilloscope::Oscilloscope( QWidget * _p ) :
 	m_background( embed::getIconPixmap( "output_graph" ) ),
 	m_points( new QPointF[Engine::audioEngine()->framesPerPeriod()] ),
 	m_active( false ),
+	m_needsRepaint( true ),
+	m_bufferSilent( false ),
 	m_leftChannelColor(71, 253, 133),
 	m_rightChannelColor(71, 253, 133),
 	m_otherChannelsColor(71, 253, 133),
@@ -81,6 +85,24 @@ void Oscilloscope::updateAudioBuffer( const surroundSampleFrame * buffer )
 	{
 		const fpp_t fpp = Engine::audioEngine()->framesPerPeriod();
 		memcpy( m_buffer, buffer, sizeof( surroundSampleFrame ) * fpp );
+
+		// repeated silence looks the same, so it only has to be drawn once
+		const bool silent = std::all_of( m_buffer, m_buffer + fpp,
+			[]( const sampleFrame & frame ) { return frame[0] == 0.0f && frame[1] == 0.0f; } );
+		m_needsRepaint = m_needsRepaint || !silent || !m_bufferSilent;
+		m_bufferSilent = silent;
+	}
+}
+
+
+
+
+void Oscilloscope::periodicUpdate()
+{
+	if( m_needsRepaint && isVisible() )
+	{
+		m_needsRepaint = false;
+		update();
 	}
 }
 
@@ -94,7 +116,7 @@ void Oscilloscope::setActive( bool _active )
 	{
 		connect( getGUI()->mainWindow(),
 					SIGNAL(periodicUpdate()),
-					this, SLOT(update()));
+					this, SLOT(periodicUpdate()));
 		connect( Engine::audioEngine(),
 			SIGNAL(nextAudioBuffer(const lmms::surroundSampleFrame*)),
 			this, SLOT(updateAudioBuffer(const lmms::surroundSampleFrame*)) );
@@ -103,7 +125,7 @@ void Oscilloscope::setActive( bool _active )
 	{
 		disconnect( getGUI()->mainWindow(),
 					SIGNAL(periodicUpdate()),
-					this, SLOT(update()));
+					this, SLOT(periodicUpdate()));
 		disconnect( Engine::audioEngine(),
 			SIGNAL( nextAudioBuffer( const lmms::surroundSampleFrame* ) ),
 			this, SLOT( updateAudioBuffer( const lmms::surroundSampleFrame* ) ) );
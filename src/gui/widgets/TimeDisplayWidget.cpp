@@ -86,6 +86,8 @@ void TimeDisplayWidget::setDisplayMode( DisplayMode displayMode )
 
 void TimeDisplayWidget::updateTime()
 {
+	if( !isVisible() ) { return; }
+
 	Song* s = Engine::getSong();
 
 	switch( m_displayMode )
@@ -138,6 +138,72 @@ void MidiClip::init()
 
 void MidiClip::updateLength()
 {
+	// The notes may have been changed through notes() since the extents were recorded
+	m_noteExtentsDirty = true;
+	applyNoteExtents();
+}
+
+
+
+
+void MidiClip::addNoteExtents(const Note* note)
+{
+	if (note->length() > 0)
+	{
+		m_noteEnds.insert(note->endPos());
+	}
+	if (note->type() == Note::Type::Step)
+	{
+		m_stepPositions.insert(note->pos());
+	}
+}
+
+
+
+
+void MidiClip::removeNoteExtents(const Note* note)
+{
+	const auto removeOne = [this](std::multiset<tick_t>& extents, tick_t value)
+	{
+		const auto it = extents.find(value);
+		if (it != extents.end()) { extents.erase(it); }
+		// The note has been changed since it was recorded
+		else { m_noteExtentsDirty = true; }
+	};
+
+	if (note->length() > 0)
+	{
+		removeOne(m_noteEnds, note->endPos());
+	}
+	if (note->type() == Note::Type::Step)
+	{
+		removeOne(m_stepPositions, note->pos());
+	}
+}
+
+
+
+
+void MidiClip::syncNoteExtents()
+{
+	if (!m_noteExtentsDirty) { return; }
+
+	m_noteEnds.clear();
+	m_stepPositions.clear();
+	for (const auto& note : m_notes)
+	{
+		addNoteExtents(note);
+	}
+	m_noteExtentsDirty = false;
+}
+
+
+
+
+void MidiClip::applyNoteExtents()
+{
+	syncNoteExtents();
+
 	if( m_clipType == Type::BeatClip )
 	{
 		changeLength( beatClipLength() );
@@ -146,13 +212,9 @@ void MidiClip::updateLength()
 	}
 
 	tick_t max_length = TimePos::ticksPerBar();
-
-	for (const auto& note : m_notes)
+	if (!m_noteEnds.empty())
 	{
-		if (note->length() > 0)
-		{
-			max_length = std::max<tick_t>(max_length, note->endPos());
-		}
+		max_length = std::max<tick_t>(max_length, *m_noteEnds.rbegin());
 	}
 	changeLength( TimePos( max_length ).nextFullBar() *
 						TimePos::ticksPerBar() );
@@ -166,12 +228,9 @@ TimePos MidiClip::beatClipLength() const
 {
 	tick_t max_length = TimePos::ticksPerBar();
 
-	for (const auto& note : m_notes)
+	if (!m_stepPositions.empty())
 	{
-		if (note->type() == Note::Type::Step)
-		{
-			max_length = std::max<tick_t>(max_length, note->pos() + 1);
-		}
+		max_length = std::max<tick_t>(max_length, *m_stepPositions.rbegin() + 1);
 	}
 
 	if (m_steps != TimePos::stepsPerBar())
@@ -196,9 +255,10 @@ Note * MidiClip::addNote( const Note & _new_note, const bool _quant_pos )
 	instrumentTrack()->lock();
 	m_notes.insert(std::upper_bound(m_notes.begin(), m_notes.end(), new_note, Note::lessThan), new_note);
 	instrumentTrack()->unlock();
+	addNoteExtents(new_note);
 
 	checkType();
-	updateLength();
+	applyNoteExtents();
 
 	emit dataChanged();
 
@@ -208,15 +268,49 @@ Note * MidiClip::addNote( const Note & _new_note, const bool _quant_pos )
 
 
 
+void MidiClip::addNotes(const std::vector<Note>& notes)
+{
+	if (notes.empty()) { return; }
+
+	auto newNotes = NoteVector{};
+	newNotes.reserve(notes.size());
+	for (const auto& note : notes)
+	{
+		newNotes.push_back(new Note(note));
+	}
+	std::stable_sort(newNotes.begin(), newNotes.end(), Note::lessThan);
+
+	instrumentTrack()->lock();
+	const auto oldCount = m_notes.size();
+	m_notes.insert(m_notes.end(), newNotes.begin(), newNotes.end());
+	// Like addNote(), new notes go after existing notes at the same position
+	std::inplace_merge(m_notes.begin(), m_notes.begin() + oldCount, m_notes.end(), Note::lessThan);
+	instrumentTrack()->unlock();
+
+	for (const auto note : newNotes)
+	{
+		addNoteExtents(note);
+	}
+
+	checkType();
+	applyNoteExtents();
+
+	emit dataChanged();
+}
+
+
+
+
 NoteVector::const_iterator MidiClip::removeNote(NoteVector::const_iterator it)
 {
+	removeNoteExtents(*it);
 	instrumentTrack()->lock();
 	delete *it;
 	auto new_it = m_notes.erase(it);
 	instrumentTrack()->unlock();
 
 	checkType();
-	updateLength();
+	applyNoteExtents();
 
 	emit dataChanged();
 	return new_it;
@@ -229,6 +323,7 @@ NoteVector::const_iterator MidiClip::removeNote(Note* note)
 	auto it = std::find(m_notes.begin(), m_notes.end(), note);
 	if (it != m_notes.end())
 	{
+		removeNoteExtents(*it);
 		delete *it;
 		it = m_notes.erase(it);
 	}
@@ -236,7 +331,7 @@ NoteVector::const_iterator MidiClip::removeNote(Note* note)
 	instrumentTrack()->unlock();
 
 	checkType();
-	updateLength();
+	applyNoteExtents();
 
 	emit dataChanged();
 	return it;
@@ -276,6 +371,9 @@ void MidiClip::clearNotes()
 	}
 	m_notes.clear();
 	instrumentTrack()->unlock();
+	m_noteEnds.clear();
+	m_stepPositions.clear();
+	m_noteExtentsDirty = false;
 
 	checkType();
 	emit dataChanged();
@@ -333,7 +431,9 @@ void MidiClip::splitNotes(const NoteVector& notes, TimePos pos)
 		}
 
 		// Reduce note length
+		removeNoteExtents(note);
 		note->setLength(leftLength);
+		addNoteExtents(note);
 
 		// Add new note with the remaining length
 		Note newNote = Note(*note);
@@ -361,8 +461,10 @@ void MidiClip::setType( Type _new_clip_type )
 
 void MidiClip::checkType()
 {
+	syncNoteExtents();
+
 	// If all notes are StepNotes, we have a BeatClip
-	const auto beatClip = std::all_of(m_notes.begin(), m_notes.end(), [](auto note) { return note->type() == Note::Type::Step; });
+	const auto beatClip = m_stepPositions.size() == m_notes.size();
 
 	setType(beatClip ? Type::BeatClip : Type::MelodyClip);
 }
@@ -438,6 +540,7 @@ void MidiClip::loadSettings( const QDomElement & _this )
 		}
 		node = node.nextSibling();
         }
+	m_noteExtentsDirty = true;
 
 	m_steps = _this.attribute( "steps" ).toInt();
 	if( m_steps == 0 )
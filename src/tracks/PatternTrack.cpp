@@ -116,7 +116,7 @@ bool PatternTrack::play( const TimePos & _start, const fpp_t _frames,
 		{
 			lastPosition = clip->startPosition();
 			lastLength = clip->length();
-			tick_t patternLength = Engine::patternStore()->lengthOfPattern(static_cast<PatternClip*>(clip)->patternIndex())
+			tick_t patternLength = Engine::patternStore()->playbackLengthOfPattern(static_cast<PatternClip*>(clip)->patternIndex())
 					* TimePos::ticksPerBar();
 			lastOffset = patternLength - (clip->startTimeOffset() % patternLength);
 			if (lastOffset == patternLength)
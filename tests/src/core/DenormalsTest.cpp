@@ -0,0 +1,71 @@
+/*
+ * DenormalsTest.cpp
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <cfloat>
+#include <cmath>
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+#include "BasicFilters.h"
+#include "denormals.h"
+
+class DenormalsTest : public QObject
+{
+	Q_OBJECT
+private slots:
+	void FlushToZeroTest()
+	{
+		using namespace lmms;
+		if (!CAN_FLUSH_DENORMALS)
+		{
+			QSKIP("Denormals can't be flushed on this architecture");
+		}
+
+		disable_denormals();
+		QVERIFY(denormals_are_flushed());
+
+		volatile float smallest = FLT_MIN;
+		volatile float half = smallest * 0.5f;
+		QCOMPARE(static_cast<float>(half), 0.f);
+	}
+
+	void FilterDecayTest()
+	{
+		using namespace lmms;
+		// As in the render threads, either the flags or the filter itself have to protect it
+		disable_denormals();
+
+		// y[n] = x[n] + 0.5 y[n-1] decays into the denormal range after an impulse
+		auto filter = BiQuad<1>{};
+		filter.setCoeffs(-0.5f, 0.f, 1.f, 0.f, 0.f);
+
+		filter.update(1.f, 0);
+		for (int i = 0; i < 1000; ++i)
+		{
+			QVERIFY(std::fpclassify(filter.update(0.f, 0)) != FP_SUBNORMAL);
+		}
+	}
+};
+
+QTEST_GUILESS_MAIN(DenormalsTest)
+#include "DenormalsTest.moc"